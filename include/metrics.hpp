@@ -0,0 +1,71 @@
+/**
+ * @headerfile	metrics.hpp "metrics.hpp"
+ * @file	metrics.hpp
+ * @brief	작업 처리 통계
+ * @details	쓰레드별 카운터에 기록하고 조회 시에만 합산하므로 기록 시 잠금이 없다.
+ * @date	2026. 10. 16. 17:02:11
+ * @see		worker.hpp
+ */
+#ifndef ITF_METRICS_H
+#define ITF_METRICS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+namespace itfact {
+	namespace worker {
+		/**
+		 * @brief	작업 처리 단계
+		 */
+		enum METRIC_STAGE {
+			STAGE_WAIT,		///< 작업 대기 (이전 작업 종료 후 다음 작업 수신까지)
+			STAGE_DOWNLOAD,	///< 녹취 다운로드
+			STAGE_FORMAT,	///< 포멧 확인
+			STAGE_DECODE,	///< 디코딩 (외부 디코더 또는 decode_wave)
+			STAGE_RESAMPLE,	///< 채널 합성, 표본화율 변환
+			STAGE_VAD,		///< 비음성 구간 제거
+			STAGE_SETUP,	///< 디코더 컨텍스트 준비 (생성 또는 초기화)
+			STAGE_FRONTEND,	///< 특징 추출 (stepFrameLFrontEnd)
+			STAGE_SEARCH,	///< 탐색 (stepSARecFrameExt)
+			STAGE_RESULT,	///< 인식 결과 (getWBAdjustedResultSLaser)
+			STAGE_POSTPROC,	///< 후처리 (unsegment, ssp)
+			STAGE_SEND,		///< 결과 전송
+			STAGE_MAX
+		};
+
+		enum METRIC_COUNTER {
+			COUNTER_JOBS,	///< 처리한 작업
+			COUNTER_FAILED,	///< 실패한 작업
+			COUNTER_BYTES,	///< 수신한 음성 데이터
+			COUNTER_FRAMES,	///< 탐색한 프레임
+			COUNTER_CONTEXTS,	///< 생성한 디코더 컨텍스트
+			COUNTER_SKIPPED,	///< 비음성으로 제거한 샘플
+			COUNTER_MAX
+		};
+
+		class Metrics : private boost::noncopyable
+		{
+		public: // const
+			static const std::size_t MAX_ERROR_CODES = 32;
+
+		public:
+			static void observe(const enum METRIC_STAGE stage, const double seconds);
+			static void observe(const enum METRIC_STAGE stage, const std::chrono::steady_clock::time_point &start);
+			static void observeRTF(const double rtf);
+			static void add(const enum METRIC_COUNTER counter, const uint64_t value = 1);
+			static void fail(const std::string &code);
+
+			static std::string expose();
+			static double stageSeconds(const enum METRIC_STAGE stage);
+			static const char *stageName(const enum METRIC_STAGE stage);
+
+		private:
+			Metrics();
+		};
+	}
+}
+
+#endif /* ITF_METRICS_H */
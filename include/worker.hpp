@@ -11,8 +11,14 @@
 #ifndef ITF_WORKER_H
 #define ITF_WORKER_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <exception>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <random>
 #include <memory>
 #include <string>
 #include <thread>
@@ -24,6 +30,7 @@
 #include <libgearman/gearman.h>
 
 #include "configuration.hpp"
+#include "metrics.hpp"
 
 namespace itfact {
 	namespace worker {
@@ -39,14 +46,157 @@ namespace itfact {
 			PROTOCOL_NONE
 		};
 
+		/**
+		 * @brief	  
+		 * @details	/Ʈ  б  mmap ϰ (Ʈũ  ý̳ master.mmap = false ̸ read),
+		 			ٿε ʹ Content-Length ũ ̸ Ҵ ۿ Ѵ.
+		 */
+		class AudioBuffer : private boost::noncopyable
+		{
+		private: // Member
+			char *mapped = NULL;
+			std::size_t mapped_size = 0;
+			std::vector<char> owned;
+
+		public:
+			AudioBuffer() {};
+			~AudioBuffer();
+
+			void map(const std::string &pathname, const bool allow_mmap = true);
+			void reserve(const std::size_t bytes) {owned.reserve(bytes);};
+			void append(const char *source, const std::size_t bytes);
+			void assign(std::vector<char> &&source);
+			void clear();
+
+			const short *data() const {
+				return (const short *) (mapped ? mapped : owned.data());
+			};
+			std::size_t size() const {return bytes() / sizeof(short);};
+			std::size_t bytes() const {return (mapped ? mapped_size : owned.size());};
+			bool empty() const {return bytes() < sizeof(short);};
+			bool isMapped() const {return mapped != NULL;};
+		};
+
+		/**
+		 * @brief	庰 CURL ڵ Ǯ
+		 * @details	帶 ϳ easy ڵ ϸ,
+		 			DNS, TLS , Ŀؼ ĳô CURLSH   ڵ Ѵ.
+		 */
+		class CurlPool : private boost::noncopyable
+		{
+		public:
+			static CURL *getHandle();
+
+		private:
+			CurlPool();
+		};
+
+		class ComputePool;
+		class WorkerDaemon;
+
+		/**
+		 * @brief	Job server
+		 */
+		struct JobServer {
+			std::string host;
+			in_port_t port;
+		};
+
+		/**
+		 * @brief	Job server    
+		 * @details	 ߻ϸ   TCP  õϿ ϴ  ϵ ϸ,
+		 			  ٲ generation  ϹǷ Ŀ ̸   ٽ Ѵ.
+		 */
+		class JobServers : private boost::noncopyable
+		{
+		private: // Member
+			std::vector<JobServer> servers;
+			std::vector<bool> alive;
+			std::atomic<unsigned long> generation{0};
+			std::chrono::steady_clock::time_point last_check;
+			long recheck_interval = 10 * 1000;
+			mutable std::mutex lock;
+
+		public:
+			void configure(const std::string &hosts, const in_port_t default_port, const long interval,
+						   log4cpp::Category *logger);
+			bool empty() const {return servers.empty();};
+			unsigned long getGeneration() const {return generation;};
+			std::vector<JobServer> getAvailable(const std::size_t rotate = 0) const;
+			std::vector<JobServer> getAll() const;
+			void check(log4cpp::Category *logger, const bool force = true);
+
+			static int connect(const JobServer &server, const long timeout);
+		};
+
+		/**
+		 * @brief	Jitter     
+		 */
+		class Backoff
+		{
+		private: // Member
+			long base;
+			long max;
+			unsigned int attempt = 0;
+			std::mt19937 random;
+
+		public:
+			Backoff(const long base_msec, const long max_msec);
+			long next();
+			void reset() {attempt = 0;};
+		};
+
+		/**
+		 * @brief	Ŀ Լ 
+		 */
+		struct JobFunction {
+			std::string name;
+			void *context;
+			gearman_return_t (*fn)(gearman_job_st *, void *);
+			WorkerDaemon *daemon;
+		};
+
+		/**
+		 * @brief	Լ Ŀ  
+		 * @details	  max  Ǹ, ȣ target   Ը  ϵȴ.
+		 */
+		struct WorkerSlots {
+			std::string name;
+			std::atomic<unsigned long> target;
+			unsigned long min;
+			unsigned long max;
+
+			WorkerSlots(const std::string &function, const unsigned long count,
+						const unsigned long lower, const unsigned long upper)
+				: name(function), target(count), min(lower), max(upper) {};
+		};
+
 		class WorkerDaemon : private boost::noncopyable
 		{
 		private: // Member
 			std::vector<std::thread> workers;
-			bool is_running = false;
+			std::atomic<bool> is_running{false};
+			std::atomic<unsigned long> active_jobs{0};
 			common::Configuration config;
 			log4cpp::Category *logger;
 
+			//   (drain)
+			std::mutex state_lock;
+			std::condition_variable state_cv;
+			std::thread drain_watchdog;
+			bool drained = false;
+
+			JobServers servers;
+
+			//  й 
+			std::vector<std::shared_ptr<WorkerSlots>> slots;
+			std::thread controller;
+
+			// event  
+			std::vector<JobFunction> functions;
+			std::shared_ptr<ComputePool> compute_pool;	///< thread 忡  ó 
+			std::once_flag compute_once;
+
 		public:
 			WorkerDaemon();
 			WorkerDaemon(const int argc, const char *argv[]);
@@ -54,6 +204,7 @@ namespace itfact {
 			int initialize(const int argc, const char *argv[]);
 			virtual int initialize() = 0;
 			void stop();
+			bool waitForStop(const long msec);
 
 			const common::Configuration *getConfig() {return &config;};
 			const common::Configuration *getConfig() const {return &config;};
@@ -63,28 +214,74 @@ namespace itfact {
 			unsigned long getTotalWorkers(const std::string &name);
 			bool isRunning() {return is_running;};
 			bool isRunning() const {return is_running;};
+			unsigned long getActiveJobs() const {return active_jobs;};
 			std::string getHost() {return config.getHost();};
 			std::string getHost() const {return config.getHost();};
 			in_port_t getPort() {return static_cast<in_port_t>(config.getPort());};
 			in_port_t getPort() const {return static_cast<in_port_t>(config.getPort());};
 			long getTimeout() {return config.getTimeout();};
 			long getTimeout() const {return config.getTimeout();};
+			JobServers *getJobServers() {return &servers;};
+			Backoff getBackoff() const;
 
 			static enum PROTOCOL
 			downloadData(const common::Configuration *config,
 						 const char *workload, const size_t workload_size,
-						 std::vector<short> &buffer, const std::string *account = NULL,
+						 AudioBuffer &buffer, const std::string *account = NULL,
 						 log4cpp::Category *logger = &log4cpp::Category::getRoot());
 			static CURLcode uploadData( const common::Configuration *config,
 										const std::string &uri, const std::string &pathname,
 										const std::string *account = NULL,
 										log4cpp::Category *logger = &log4cpp::Category::getRoot());
 
+			// ۾   (event 忡 ۾  I/O 尡 )
+			static gearman_return_t sendComplete(gearman_job_st *job, const void *result, const size_t result_size);
+			static gearman_return_t sendData(gearman_job_st *job, const void *data, const size_t data_size);
+			static gearman_return_t sendWarning(gearman_job_st *job, const void *warning, const size_t warning_size);
+			static gearman_return_t sendFail(gearman_job_st *job);
+
+			static gearman_return_t execute(gearman_job_st *job, void *function);
+
+			bool submitHelper(std::function<void()> task);
+
 		protected:
+			void catchSignals();
 			void run(const std::string name, void *context, unsigned int count,
 					 gearman_return_t (*fn)(gearman_job_st *, void *));
 			void join();
 
+		private:
+			int getPollInterval() const;
+			bool isEventIntake() const;
+			bool isRebalancing() const;
+			void rebalance();
+			void startIntake();
+			std::shared_ptr<ComputePool> getComputePool();
+
+		};
+
+		/**
+		 * @brief	۾ ϳ  Ǯ  Կ  ó
+		 * @details	   spawn()  false  ȯϹǷ ȣ 尡  óؾ Ѵ.
+		 			Ҹ    ó  ⸦ ٸ.
+		 */
+		class TaskGroup : private boost::noncopyable
+		{
+		private: // Member
+			WorkerDaemon *daemon;
+			std::mutex lock;
+			std::condition_variable finished;
+			std::size_t running = 0;
+
+		public:
+			explicit TaskGroup(WorkerDaemon *owner) : daemon(owner) {};
+			~TaskGroup() {wait();};
+
+			bool spawn(std::function<void()> task);
+			void wait();
+
+		private:
+			void done();
 		};
 	}
 }
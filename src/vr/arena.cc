@@ -0,0 +1,197 @@
+/**
+ * @file	arena.cc
+ * @brief	특징 벡터 버퍼 할당
+ * @details	버퍼 크기는 mfcc_size 와 mini_batch 로 정해지는 몇 가지뿐이므로 크기별로 해제된 버퍼를 모아 둔다.
+ 			쓰레드 캐시가 가득 차거나 쓰레드가 끝나면 공용 풀로 옮기며, 할당한 메모리는 프로세스가 끝날 때까지
+ 			돌려주지 않는다.
+ * @date	2026. 10. 17. 19:02:11
+ * @see		arena.hpp
+ */
+#include <sys/mman.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#include "arena.hpp"
+
+using namespace itfact::vr::node;
+
+namespace {
+	typedef std::unordered_map<std::size_t, std::vector<void *>> BlockMap;
+
+	std::atomic<bool> huge_pages(false);
+
+	/// 공용 풀과 새 버퍼를 잘라 낼 슬랩
+	struct SharedPool {
+		std::mutex lock;
+		BlockMap blocks;
+		char *slab = NULL;
+		std::size_t left = 0;
+	};
+
+	SharedPool &shared_pool() {
+		static SharedPool *pool = new SharedPool();	// 쓰레드 캐시 소멸자보다 늦게 사라지도록 해제하지 않음
+		return *pool;
+	}
+
+	struct ThreadCache {
+		BlockMap blocks;
+
+		~ThreadCache() {
+			SharedPool &pool = shared_pool();
+			std::lock_guard<std::mutex> guard(pool.lock);
+			for (auto &item : blocks) {
+				std::vector<void *> &shared = pool.blocks[item.first];
+				shared.insert(shared.end(), item.second.begin(), item.second.end());
+			}
+		}
+	};
+
+	thread_local ThreadCache thread_cache;
+
+	/**
+	 * @brief	SLAB_SIZE 의 배수인 영역을 SLAB_SIZE 경계에 할당
+	 * @details	MAP_HUGETLB 가 실패하면 일반 페이지로 할당하고 투명 huge page 를 요청한다.
+	 			경계를 맞추기 위해 한 슬랩만큼 더 할당한 뒤 앞뒤를 돌려준다.
+	 */
+	void *map_region(const std::size_t bytes) {
+		void *region = MAP_FAILED;
+#ifdef MAP_HUGETLB
+		if (huge_pages)
+			region = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (region != MAP_FAILED)
+			return region;
+#endif
+
+		const std::size_t slab = FeatureArena::SLAB_SIZE;
+		region = mmap(NULL, bytes + slab, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (region == MAP_FAILED)
+			return NULL;
+		uintptr_t begin = reinterpret_cast<uintptr_t>(region);
+		uintptr_t aligned = (begin + slab - 1) & ~static_cast<uintptr_t>(slab - 1);
+		if (aligned > begin)
+			munmap(region, aligned - begin);
+		if (aligned < begin + slab)
+			munmap(reinterpret_cast<void *>(aligned + bytes), begin + slab - aligned);
+#ifdef MADV_HUGEPAGE
+		if (huge_pages)
+			madvise(reinterpret_cast<void *>(aligned), bytes, MADV_HUGEPAGE);
+#endif
+		return reinterpret_cast<void *>(aligned);
+	}
+
+	inline std::size_t block_bytes(const std::size_t count) {
+		const std::size_t align = FeatureArena::ALIGNMENT;
+		return (count * sizeof(float) + align - 1) & ~(align - 1);
+	}
+}
+
+/**
+ * @brief		huge page 사용 여부
+ * @details		이후 새로 할당하는 슬랩부터 적용된다.
+ */
+void FeatureArena::setHugePages(const bool enable) {
+	huge_pages = enable;
+}
+
+/**
+ * @brief		버퍼 할당
+ * @details		쓰레드 캐시, 공용 풀, 슬랩 순으로 찾는다. 슬랩의 절반보다 큰 버퍼는 따로 할당한다.
+ * @param[in]	count	float 개수
+ * @return		ALIGNMENT 경계의 버퍼
+ * @exception	std::bad_alloc	메모리가 부족한 경우
+ */
+float *FeatureArena::allocate(const std::size_t count) {
+	const std::size_t bytes = block_bytes(count);
+	std::vector<void *> &cached = thread_cache.blocks[bytes];
+	if (!cached.empty()) {
+		void *block = cached.back();
+		cached.pop_back();
+		return static_cast<float *>(block);
+	}
+
+	SharedPool &pool = shared_pool();
+	if (bytes > SLAB_SIZE / 2) {
+		{
+			std::lock_guard<std::mutex> guard(pool.lock);
+			std::vector<void *> &shared = pool.blocks[bytes];
+			if (!shared.empty()) {
+				void *block = shared.back();
+				shared.pop_back();
+				return static_cast<float *>(block);
+			}
+		}
+		void *block = map_region((bytes + SLAB_SIZE - 1) & ~(SLAB_SIZE - 1));
+		if (!block)
+			throw std::bad_alloc();
+		return static_cast<float *>(block);
+	}
+
+	std::lock_guard<std::mutex> guard(pool.lock);
+	std::vector<void *> &shared = pool.blocks[bytes];
+	if (!shared.empty()) {
+		void *block = shared.back();
+		shared.pop_back();
+		return static_cast<float *>(block);
+	}
+	if (pool.left < bytes) {
+		pool.slab = static_cast<char *>(map_region(SLAB_SIZE));
+		if (!pool.slab) {
+			pool.left = 0;
+			throw std::bad_alloc();
+		}
+		pool.left = SLAB_SIZE;
+	}
+	void *block = pool.slab;
+	pool.slab += bytes;
+	pool.left -= bytes;
+	return static_cast<float *>(block);
+}
+
+/**
+ * @brief		버퍼 반납
+ * @param[in]	block	allocate() 로 받은 버퍼
+ * @param[in]	count	allocate() 에 준 float 개수
+ */
+void FeatureArena::release(float *block, const std::size_t count) {
+	if (!block)
+		return;
+	const std::size_t bytes = block_bytes(count);
+	std::vector<void *> &cached = thread_cache.blocks[bytes];
+	if (cached.size() < THREAD_CACHE) {
+		cached.push_back(block);
+		return;
+	}
+
+	SharedPool &pool = shared_pool();
+	std::lock_guard<std::mutex> guard(pool.lock);
+	pool.blocks[bytes].push_back(block);
+}
+
+/**
+ * @brief		해제되면 arena 로 돌아가는 버퍼
+ */
+std::shared_ptr<float> FeatureArena::make_shared(const std::size_t count) {
+	return std::shared_ptr<float>(allocate(count), [count](float *block) {release(block, count);});
+}
+
+/**
+ * @brief		mini_batch 에 못 미치는 뒷부분을 sil 로 채움
+ * @details		nf 번째 프레임부터 sil 의 처음부터 복사한다. 엔진(calcDNN2SetLogExt 의 정규화 등)이나
+ 				stepFrameLFrontEnd 가 뒷부분을 바꾸지 않는다는 보장이 없으므로 매번 복사한다.
+ * @param[in]	nf			채운 프레임 수
+ * @param[in]	sil			묵음 특징 벡터
+ * @param[in]	mfcc_size	프레임당 특징 벡터 차원
+ * @param[in]	mini_batch	미니배치 프레임 수
+ */
+void FeatureBuffer::pad(const std::size_t nf, const float *sil, const std::size_t mfcc_size,
+						const std::size_t mini_batch) {
+	if (nf >= mini_batch)
+		return;
+	std::memcpy(block.get() + nf * mfcc_size, sil, sizeof(float) * mfcc_size * (mini_batch - nf));
+}
@@ -0,0 +1,60 @@
+/**
+ * @headerfile	arena.hpp "arena.hpp"
+ * @file	arena.hpp
+ * @brief	특징 벡터 버퍼 할당
+ * @details	특징 벡터와 임시 버퍼는 2MiB 슬랩에서 64 바이트 경계로 잘라 쓰고, 해제된 버퍼는 해제한 쓰레드의
+ 			캐시에 두었다가 다음 작업이나 채널에 다시 준다. stt.hugepages 가 true 이면 슬랩을 MAP_HUGETLB 로,
+ 			예약된 huge page 가 없으면 투명 huge page(MADV_HUGEPAGE)로 할당한다.
+ * @date	2026. 10. 17. 19:02:11
+ * @see		arena.cc
+ */
+#ifndef __ITFACT_VR_ARENA_H__
+#define __ITFACT_VR_ARENA_H__
+
+#include <cstddef>
+#include <memory>
+
+namespace itfact {
+	namespace vr {
+		namespace node {
+			class FeatureArena
+			{
+			public: // const
+				static const std::size_t ALIGNMENT = 64;
+				static const std::size_t SLAB_SIZE = 2 * 1024 * 1024;
+				static const std::size_t THREAD_CACHE = 8;	///< 쓰레드별로 크기마다 남겨 둘 버퍼 수
+
+			public:
+				static void setHugePages(const bool enable);
+				static float *allocate(const std::size_t count);
+				static void release(float *block, const std::size_t count);
+				static std::shared_ptr<float> make_shared(const std::size_t count);
+
+			private:
+				FeatureArena();
+			};
+
+			/**
+			 * @brief	미니배치 특징 벡터 버퍼
+			 * @details	mini_batch 보다 적은 프레임을 채운 뒤 나머지를 sil 로 채운다.
+			 */
+			class FeatureBuffer
+			{
+			private: // Member
+				std::shared_ptr<float> block;
+
+			public:
+				FeatureBuffer() {};
+				explicit FeatureBuffer(const std::shared_ptr<float> &buffer) : block(buffer) {};
+
+				float *get() const {return block.get();};
+				explicit operator bool() const {return static_cast<bool>(block);};
+
+				void pad(const std::size_t nf, const float *sil, const std::size_t mfcc_size,
+						 const std::size_t mini_batch);
+			};
+		}
+	}
+}
+
+#endif /* __ITFACT_VR_ARENA_H__ */
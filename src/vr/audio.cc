@@ -0,0 +1,490 @@
+/**
+ * @file	audio.cc
+ * @brief	녹취 데이터 변환
+ * @date	2026. 10. 17. 15:48:03
+ * @see		vr_server.cc
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AUDIO_X86
+#endif
+
+#include "audio.hpp"
+
+using namespace itfact::vr::node;
+
+static inline uint16_t read_le16(const char *p) {
+	const unsigned char *u = (const unsigned char *) p;
+	return static_cast<uint16_t>(u[0] | (u[1] << 8));
+}
+
+static inline uint32_t read_le32(const char *p) {
+	const unsigned char *u = (const unsigned char *) p;
+	return static_cast<uint32_t>(u[0]) | (static_cast<uint32_t>(u[1]) << 8) |
+		   (static_cast<uint32_t>(u[2]) << 16) | (static_cast<uint32_t>(u[3]) << 24);
+}
+
+/**
+ * @brief		RIFF/WAVE 해석
+ * @details		fmt 청크와 data 청크를 찾을 때까지 청크를 건너뛴다. 청크는 짝수 바이트로 정렬되며,
+ 				녹음 중 기록된 파일은 data 크기가 0 이나 0xFFFFFFFF 인 경우가 있어 파일 끝까지로 본다.
+ * @date		2026. 10. 17. 16:14:20
+ * @param[in]	buffer	녹취 데이터 
+ * @param[in]	size	녹취 데이터 크기 (byte)
+ * @param[out]	info	WAVE 헤더 정보
+ * @return		fmt 와 data 청크를 모두 찾으면 true
+ */
+bool itfact::vr::node::parse_wave(const char *buffer, const std::size_t size, WaveInfo &info) {
+	info = WaveInfo();
+	if (size < 12 || std::strncmp(buffer, "RIFF", 4) != 0 || std::strncmp(buffer + 8, "WAVE", 4) != 0)
+		return false;
+
+	bool has_format = false;
+	std::size_t offset = 12;
+	while (offset + 8 <= size) {
+		const char *chunk = buffer + offset;
+		std::size_t chunk_size = read_le32(chunk + 4);
+		std::size_t remain = size - offset - 8;
+
+		if (std::strncmp(chunk, "fmt ", 4) == 0) {
+			if (chunk_size < 16 || chunk_size > remain)
+				return false;
+			info.encoding = read_le16(chunk + 8);
+			info.channels = read_le16(chunk + 10);
+			info.sample_rate = read_le32(chunk + 12);
+			info.block_align = read_le16(chunk + 20);
+			info.bits = read_le16(chunk + 22);
+			// WAVEFORMATEXTENSIBLE: cbSize(2) wValidBitsPerSample(2) dwChannelMask(4) SubFormat(16)
+			if (info.encoding == ENCODING_EXTENSIBLE && chunk_size >= 40)
+				info.encoding = read_le16(chunk + 32);
+			has_format = true;
+		} else if (std::strncmp(chunk, "data", 4) == 0) {
+			if (!has_format)
+				return false;
+			info.data = chunk + 8;
+			info.data_size = (chunk_size == 0 || chunk_size > remain) ? remain : chunk_size;
+			return true;
+		}
+
+		if (chunk_size > remain)
+			return false;
+		offset += 8 + chunk_size + (chunk_size & 1);
+	}
+	return false;
+}
+
+/**
+ * @brief		decode_wave() 로 변환할 수 있는지 확인
+ * @date		2026. 10. 17. 16:18:02
+ */
+bool itfact::vr::node::can_decode_wave(const WaveInfo &info) {
+	if (!info.data || info.channels == 0 || info.block_align != info.channels * ((info.bits + 7) / 8))
+		return false;
+	switch (info.encoding) {
+	case ENCODING_PCM:
+		return info.bits == 8 || info.bits == 16 || info.bits == 24 || info.bits == 32;
+	case ENCODING_FLOAT:
+		return info.bits == 32 || info.bits == 64;
+	case ENCODING_ALAW:
+	case ENCODING_MULAW:
+		return info.bits == 8;
+	default:
+		return false;
+	}
+}
+
+/**
+ * @brief	G.711 변환표
+ * @details	ITU-T G.711 의 확장 규칙을 그대로 따른다.
+ */
+struct G711Table {
+	short alaw[256];
+	short mulaw[256];
+
+	G711Table() {
+		for (int i = 0; i < 256; ++i) {
+			int a = i ^ 0x55;
+			int exponent = (a & 0x70) >> 4;
+			int value = (a & 0x0F) << 4;
+			value = exponent ? ((value + 0x108) << (exponent - 1)) : (value + 8);
+			alaw[i] = static_cast<short>((a & 0x80) ? value : -value);
+
+			int u = ~i & 0xFF;
+			exponent = (u & 0x70) >> 4;
+			value = ((((u & 0x0F) << 3) + 0x84) << exponent) - 0x84;
+			mulaw[i] = static_cast<short>((u & 0x80) ? -value : value);
+		}
+	};
+};
+
+static inline short float_to_pcm(const double value) {
+	double scaled = value * 32768.0;
+	if (scaled >= 32767.0)
+		return 32767;
+	if (scaled <= -32768.0)
+		return -32768;
+	return static_cast<short>(scaled);
+}
+
+/**
+ * @brief		WAVE 데이터를 16bit PCM 으로 변환
+ * @details		채널과 표본화율은 그대로 유지하며, 16bit 보다 큰 정수형은 상위 16bit 를 사용한다.
+ * @date		2026. 10. 17. 16:20:44
+ * @param[in]	info	parse_wave() 결과 
+ * @param[out]	pcm		16bit PCM (채널 교차 배치)
+ * @return		변환한 샘플 수 (모든 채널 합). 지원하지 않는 형식이면 0
+ */
+std::size_t itfact::vr::node::decode_wave(const WaveInfo &info, std::vector<char> &pcm) {
+	static const G711Table g711;
+	if (!can_decode_wave(info))
+		return 0;
+
+	const std::size_t width = info.bits / 8;
+	const std::size_t samples = info.data_size / info.block_align * info.channels;
+	pcm.resize(samples * sizeof(short));
+	short *output = (short *) pcm.data();
+	const unsigned char *input = (const unsigned char *) info.data;
+
+	switch (info.encoding) {
+	case ENCODING_PCM:
+		if (width == 2) {
+			std::memcpy(output, input, samples * sizeof(short));
+			break;
+		}
+		for (std::size_t i = 0; i < samples; ++i) {
+			const unsigned char *sample = input + i * width;
+			if (width == 1)
+				output[i] = static_cast<short>((sample[0] - 128) << 8);
+			else
+				output[i] = static_cast<short>(sample[width - 2] | (sample[width - 1] << 8));
+		}
+		break;
+
+	case ENCODING_FLOAT:
+		for (std::size_t i = 0; i < samples; ++i) {
+			if (width == 4) {
+				float value;
+				std::memcpy(&value, input + i * width, sizeof(value));
+				output[i] = float_to_pcm(value);
+			} else {
+				double value;
+				std::memcpy(&value, input + i * width, sizeof(value));
+				output[i] = float_to_pcm(value);
+			}
+		}
+		break;
+
+	case ENCODING_ALAW:
+		for (std::size_t i = 0; i < samples; ++i)
+			output[i] = g711.alaw[input[i]];
+		break;
+
+	case ENCODING_MULAW:
+		for (std::size_t i = 0; i < samples; ++i)
+			output[i] = g711.mulaw[input[i]];
+		break;
+	}
+	return samples;
+}
+
+/**
+ * @brief		2채널 PCM 을 채널별로 분리
+ * @details		LRLR... 을 32비트 단위로 읽어 하위 16비트(L)와 상위 16비트(R)를 각각 부호 확장한 뒤
+ 				다시 16비트로 묶는다. 값이 16비트 범위를 벗어나지 않으므로 포화 연산은 결과를 바꾸지 않는다.
+ * @date		2026. 10. 17. 15:50:26
+ * @param[in]	input	2채널 16bit PCM
+ * @param[in]	frames	채널당 샘플 수
+ * @param[out]	left	왼쪽 채널 (frames 샘플)
+ * @param[out]	right	오른쪽 채널 (frames 샘플)
+ */
+void itfact::vr::node::deinterleave_stereo(const short *input, const std::size_t frames, short *left, short *right) {
+	std::size_t i = 0;
+#ifdef __SSE2__
+	for (; i + 8 <= frames; i += 8) {
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i * 2));
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i * 2 + 8));
+		__m128i l = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+									_mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+		__m128i r = _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(left + i), l);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(right + i), r);
+	}
+#endif
+	for (; i < frames; ++i) {
+		left[i] = input[i * 2];
+		right[i] = input[i * 2 + 1];
+	}
+}
+
+/**
+ * @brief		2채널 PCM 을 단일 채널로 합침
+ * @details		_mm_madd_epi16 에 1 을 곱해 L+R 을 32비트로 구한 뒤 반으로 나눈다. 스칼라 계산과 같이
+ 				음수는 내림 처리된다.
+ * @date		2026. 10. 17. 17:02:36
+ * @param[in]	input	2채널 16bit PCM
+ * @param[in]	frames	채널당 샘플 수
+ * @param[out]	output	단일 채널 (frames 샘플)
+ */
+void itfact::vr::node::downmix_stereo(const short *input, const std::size_t frames, short *output) {
+	std::size_t i = 0;
+#ifdef __SSE2__
+	const __m128i ones = _mm_set1_epi16(1);
+	for (; i + 8 <= frames; i += 8) {
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i * 2));
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i * 2 + 8));
+		__m128i mixed = _mm_packs_epi32(_mm_srai_epi32(_mm_madd_epi16(a, ones), 1),
+										_mm_srai_epi32(_mm_madd_epi16(b, ones), 1));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), mixed);
+	}
+#endif
+	for (; i < frames; ++i)
+		output[i] = static_cast<short>((input[i * 2] + input[i * 2 + 1]) >> 1);
+}
+
+static float dot_scalar(const float *a, const float *b, const std::size_t n) {
+	float sum = 0;
+	for (std::size_t i = 0; i < n; ++i)
+		sum += a[i] * b[i];
+	return sum;
+}
+
+#ifdef AUDIO_X86
+__attribute__((target("sse2")))
+static float dot_sse2(const float *a, const float *b, const std::size_t n) {
+	__m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+	for (std::size_t i = 0; i < n; i += 8) {
+		sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+		sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+	}
+	float lanes[4];
+	_mm_storeu_ps(lanes, _mm_add_ps(sum0, sum1));
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+/**
+ * @details	FMA 의존 사슬을 줄이기 위해 16개 단위로 두 누산기를 번갈아 쓴다.
+ */
+__attribute__((target("avx2,fma")))
+static float dot_avx2(const float *a, const float *b, const std::size_t n) {
+	__m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps();
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+		sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), sum1);
+	}
+	if (i < n)
+		sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+	__m256 sum = _mm256_add_ps(sum0, sum1);
+	__m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+	half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+	half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+	return _mm_cvtss_f32(half);
+}
+#endif
+
+/**
+ * @brief	필터 길이가 8의 배수인 내적
+ */
+static float dot_product(const float *a, const float *b, const std::size_t n) {
+#ifdef AUDIO_X86
+	static const bool has_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	static const bool has_sse2 = __builtin_cpu_supports("sse2");
+	if (has_avx2)
+		return dot_avx2(a, b, n);
+	if (has_sse2)
+		return dot_sse2(a, b, n);
+#endif
+	return dot_scalar(a, b, n);
+}
+
+static inline short clamp_pcm(const float value) {
+	long sample = std::lrint(value);
+	return static_cast<short>(std::max(-32768L, std::min(32767L, sample)));
+}
+
+/**
+ * @brief		Resampler 생성
+ * @details		차단 주파수는 두 표본화율 중 낮은 쪽 Nyquist 주파수의 99%, 필터 폭은 영점 6개이다.
+ 				출력 t 는 입력 위치 (t / output_step) * input_step + first[t % output_step] 부터
+ 				taps 개의 입력으로 계산한다.
+ * @date		2026. 10. 17. 17:10:05
+ * @param[in]	in_rate		입력 표본화율 (Hz)
+ * @param[in]	out_rate	출력 표본화율 (Hz)
+ * @exception	std::invalid_argument	표본화율이 0 인 경우
+ */
+Resampler::Resampler(const uint32_t in_rate, const uint32_t out_rate)
+	: input_rate(in_rate), output_rate(out_rate) {
+	if (!in_rate || !out_rate)
+		throw std::invalid_argument("Invalid sample rate");
+
+	uint32_t a = in_rate, b = out_rate;
+	while (b) {
+		uint32_t r = a % b;
+		a = b;
+		b = r;
+	}
+	input_step = in_rate / a;
+	output_step = out_rate / a;
+	if (passthrough())
+		return;
+
+	const int num_zeros = 6;
+	const double cutoff = 0.99 * 0.5 * std::min(in_rate, out_rate);
+	const double window_width = num_zeros / (2.0 * cutoff);
+
+	std::vector<std::vector<float>> filters(output_step);
+	first.resize(output_step);
+	for (std::size_t i = 0; i < output_step; ++i) {
+		const double output_t = static_cast<double>(i) / out_rate;
+		const long min_index = static_cast<long>(std::ceil((output_t - window_width) * in_rate));
+		const long max_index = static_cast<long>(std::floor((output_t + window_width) * in_rate));
+		first[i] = min_index;
+		for (long j = min_index; j <= max_index; ++j) {
+			const double delta = static_cast<double>(j) / in_rate - output_t;
+			double weight = 0;
+			if (std::fabs(delta) < window_width) {
+				weight = 0.5 * (1 + std::cos(2 * M_PI * cutoff / num_zeros * delta));
+				weight *= (delta != 0) ? std::sin(2 * M_PI * cutoff * delta) / (M_PI * delta) : 2 * cutoff;
+			}
+			filters[i].push_back(static_cast<float>(weight / in_rate));
+		}
+		taps = std::max(taps, filters[i].size());
+	}
+
+	taps = (taps + 7) & ~static_cast<std::size_t>(7);
+	weights.assign(output_step * taps, 0.0f);
+	for (std::size_t i = 0; i < output_step; ++i)
+		std::copy(filters[i].begin(), filters[i].end(), weights.begin() + i * taps);
+	padding = static_cast<std::size_t>(std::max(0L, -*std::min_element(first.begin(), first.end())));
+	reset();
+}
+
+/**
+ * @brief	변환 상태 초기화
+ */
+void Resampler::reset() {
+	history.assign(padding, 0.0f);
+	history_start = -static_cast<long>(padding);
+	input_count = 0;
+	output_count = 0;
+}
+
+/**
+ * @brief		보관한 입력으로 계산할 수 있는 출력 생성
+ * @details		다음 출력에 필요 없는 입력은 버린다. 위상이 커질수록 첫 입력 위치도 커지므로
+ 				다음 출력의 첫 입력 위치보다 앞은 다시 쓰이지 않는다.
+ * @param[in]	limit	출력 샘플 수 상한 (누적)
+ * @param[out]	output	출력을 뒤에 붙임
+ */
+void Resampler::produce(const uint64_t limit, std::vector<short> &output) {
+	const long available = history_start + static_cast<long>(history.size());
+	while (output_count < limit) {
+		const std::size_t phase = output_count % output_step;
+		const long position = static_cast<long>(output_count / output_step * input_step) + first[phase];
+		if (position + static_cast<long>(taps) > available)
+			break;
+		output.push_back(clamp_pcm(dot_product(history.data() + (position - history_start),
+											   weights.data() + phase * taps, taps)));
+		++output_count;
+	}
+
+	const long next = static_cast<long>(output_count / output_step * input_step) + first[output_count % output_step];
+	if (next > history_start) {
+		std::size_t drop = std::min(history.size(), static_cast<std::size_t>(next - history_start));
+		history.erase(history.begin(), history.begin() + drop);
+		history_start += drop;
+	}
+}
+
+/**
+ * @brief		입력 블록 변환
+ * @param[in]	input	16bit PCM
+ * @param[in]	length	샘플 수
+ * @param[out]	output	변환된 PCM 을 뒤에 붙임. 필터 폭만큼의 출력은 다음 블록이나 flush() 에서 나온다.
+ */
+void Resampler::process(const short *input, const std::size_t length, std::vector<short> &output) {
+	if (passthrough()) {
+		output.insert(output.end(), input, input + length);
+		return;
+	}
+	history.insert(history.end(), input, input + length);
+	input_count += length;
+	produce(UINT64_MAX, output);
+}
+
+/**
+ * @brief		남은 출력을 모두 만들고 상태를 초기화
+ * @details		입력 뒤를 0 으로 채워, 입력 길이에 해당하는 ceil(input * out / in) 샘플까지 출력한다.
+ * @param[out]	output	변환된 PCM 을 뒤에 붙임
+ */
+void Resampler::flush(std::vector<short> &output) {
+	if (passthrough())
+		return;
+	const uint64_t total = (input_count * output_step + input_step - 1) / input_step;
+	history.insert(history.end(), taps + input_step, 0.0f);
+	produce(total, output);
+	reset();
+}
+
+/**
+ * @brief		PcmConverter 생성
+ * @date		2026. 10. 17. 17:26:48
+ * @param[in]	sample_rate		입력 표본화율 (Hz)
+ * @param[in]	num_channels	입력 채널 수 (1 또는 2)
+ * @exception	std::invalid_argument	지원하지 않는 입력인 경우
+ */
+PcmConverter::PcmConverter(const uint32_t sample_rate, const std::size_t num_channels)
+	: channels(num_channels), resampler(sample_rate, OUTPUT_RATE) {
+	if (num_channels != 1 && num_channels != 2)
+		throw std::invalid_argument("Invalid number of channels");
+}
+
+/**
+ * @brief		입력 블록 변환
+ * @param[in]	input	16bit PCM (2채널이면 채널 교차 배치)
+ * @param[in]	length	샘플 수 (모든 채널 합). 2채널 블록이 홀수여도 다음 블록과 이어서 처리한다.
+ * @param[out]	output	8kHz 단일 채널 PCM 을 뒤에 붙임
+ */
+void PcmConverter::process(const short *input, const std::size_t length, std::vector<short> &output) {
+	if (channels == 1)
+		return resampler.process(input, length, output);
+
+	std::size_t offset = 0;
+	mono.clear();
+	if (has_carry && length) {
+		mono.push_back(static_cast<short>((carry + input[0]) >> 1));
+		has_carry = false;
+		offset = 1;
+	}
+	const std::size_t frames = (length - offset) / 2;
+	mono.resize(mono.size() + frames);
+	downmix_stereo(input + offset, frames, mono.data() + mono.size() - frames);
+	if (offset + frames * 2 < length) {
+		carry = input[length - 1];
+		has_carry = true;
+	}
+	resampler.process(mono.data(), mono.size(), output);
+}
+
+/**
+ * @brief		남은 출력을 모두 만들고 상태를 초기화
+ * @param[out]	output	8kHz 단일 채널 PCM 을 뒤에 붙임
+ */
+void PcmConverter::flush(std::vector<short> &output) {
+	resampler.flush(output);
+	has_carry = false;
+}
+
+void PcmConverter::reset() {
+	resampler.reset();
+	has_carry = false;
+}
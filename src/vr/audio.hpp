@@ -0,0 +1,117 @@
+/**
+ * @headerfile	audio.hpp "audio.hpp"
+ * @file	audio.hpp
+ * @brief	녹취 데이터 변환
+ * @details	RIFF/WAVE 를 청크 단위로 해석하고 PCM, IEEE float, G.711 을 16bit PCM 으로 변환한다.
+ 			지원하지 않는 형식은 stt.decoder 로 변환한다.\n
+			엔진은 8kHz 단일 채널만 받으므로 PcmConverter 로 채널을 합치고 표본화율을 변환한다.
+ * @date	2026. 10. 17. 15:48:03
+ * @see		audio.cc
+ */
+#ifndef __ITFACT_VR_AUDIO_H__
+#define __ITFACT_VR_AUDIO_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace itfact {
+	namespace vr {
+		namespace node {
+			/**
+			 * @brief	WAVE 부호화 방식 (fmt 청크의 wFormatTag)
+			 */
+			enum WAVE_ENCODING {
+				ENCODING_PCM = 0x0001,
+				ENCODING_FLOAT = 0x0003,
+				ENCODING_ALAW = 0x0006,
+				ENCODING_MULAW = 0x0007,
+				ENCODING_EXTENSIBLE = 0xFFFE
+			};
+
+			/**
+			 * @brief	WAVE 헤더 정보
+			 */
+			struct WaveInfo {
+				uint16_t encoding = 0;		///< WAVE_ENCODING. EXTENSIBLE 이면 SubFormat 의 값
+				uint16_t channels = 0;
+				uint32_t sample_rate = 0;
+				uint16_t bits = 0;
+				uint16_t block_align = 0;
+				const char *data = NULL;	///< data 청크 시작
+				std::size_t data_size = 0;	///< data 청크 크기 (파일 끝을 넘지 않도록 보정)
+			};
+
+			bool parse_wave(const char *buffer, const std::size_t size, WaveInfo &info);
+			bool can_decode_wave(const WaveInfo &info);
+			std::size_t decode_wave(const WaveInfo &info, std::vector<char> &pcm);
+			void deinterleave_stereo(const short *input, const std::size_t frames, short *left, short *right);
+			void downmix_stereo(const short *input, const std::size_t frames, short *output);
+
+			/**
+			 * @brief	다위상(polyphase) 표본화율 변환
+			 * @details	Hann 창을 씌운 sinc 필터를 위상별로 미리 계산해 두고 (kaldi feat/resample.h 의
+			 			LinearResample 과 같은 방식), 입력 블록이 올 때마다 계산 가능한 출력만 만든다.
+			 			이어지는 블록은 내부에 보관한 입력과 이어서 처리하므로 한 번에 처리한 결과와 같다.
+			 */
+			class Resampler
+			{
+			private: // Member
+				uint32_t input_rate;
+				uint32_t output_rate;
+				std::size_t input_step;		///< 입력 표본화율 / gcd
+				std::size_t output_step;	///< 출력 표본화율 / gcd (위상 수)
+				std::size_t taps = 0;		///< 위상별 필터 길이 (8의 배수)
+				std::vector<long> first;	///< 위상별 첫 입력 위치 (출력 블록 기준)
+				std::vector<float> weights;	///< output_step * taps
+				std::size_t padding = 0;	///< 처음 출력에 필요한 음수 위치 입력 (0 으로 채움)
+
+				std::vector<float> history;	///< 아직 필요한 입력. history[0] 은 입력 위치 history_start
+				long history_start = 0;
+				uint64_t input_count = 0;
+				uint64_t output_count = 0;
+
+			public:
+				Resampler(const uint32_t in_rate, const uint32_t out_rate);
+
+				bool passthrough() const {return input_rate == output_rate;};
+				uint32_t getInputRate() const {return input_rate;};
+				uint32_t getOutputRate() const {return output_rate;};
+
+				void process(const short *input, const std::size_t length, std::vector<short> &output);
+				void flush(std::vector<short> &output);
+				void reset();
+
+			private:
+				void produce(const uint64_t limit, std::vector<short> &output);
+			};
+
+			/**
+			 * @brief	입력 PCM 을 8kHz 단일 채널로 변환하는 단계
+			 * @details	2채널은 먼저 합친 뒤 표본화율을 변환한다. 블록 단위로 호출하며 마지막에 flush() 한다.
+			 */
+			class PcmConverter
+			{
+			public: // const
+				static const uint32_t OUTPUT_RATE = 8000;
+
+			private: // Member
+				std::size_t channels;
+				Resampler resampler;
+				std::vector<short> mono;
+				short carry = 0;			///< 2채널 블록이 채널 중간에서 끊긴 경우 앞 채널 샘플
+				bool has_carry = false;
+
+			public:
+				PcmConverter(const uint32_t sample_rate, const std::size_t num_channels);
+
+				bool passthrough() const {return channels == 1 && resampler.passthrough();};
+				void process(const short *input, const std::size_t length, std::vector<short> &output);
+				void flush(std::vector<short> &output);
+				void reset();
+			};
+		}
+	}
+}
+
+#endif /* __ITFACT_VR_AUDIO_H__ */
@@ -0,0 +1,320 @@
+/**
+ * @file	batcher.cc
+ * @brief	여러 스트림의 음향 모델 계산을 묶어서 처리
+ * @details	calcDNN2SetLogExt() 는 t 가 미니배치의 배수일 때 미니배치 전체를 계산해 두고, 그 밖의 t 에서는
+ 			계산해 둔 행을 복사한다. 감싼 함수도 같은 규칙을 따르되, 계산은 공용 모델에 맡기고
+ 			결과는 child DNN 별로 보관한다.
+ * @date	2026. 10. 17. 18:05:12
+ * @see		batcher.hpp
+ */
+#include <algorithm>
+#include <atomic>
+
+#include "liblaserdnn2.h"
+#include "batcher.hpp"
+
+using namespace itfact::vr::node;
+
+static std::atomic<AcousticBatcher *> instance(NULL);
+static std::atomic<long> users(0);	///< 인스턴스를 사용 중인 쓰레드 수
+static thread_local SharedScores *shared_scores = NULL;
+
+/**
+ * @brief	감싼 함수가 인스턴스를 쓰는 동안 stop() 이 해제하지 않도록 사용 수 유지
+ */
+class BatcherUse : private boost::noncopyable
+{
+private: // Member
+	AcousticBatcher *batcher;
+
+public:
+	BatcherUse() {
+		++users;
+		batcher = instance.load();
+		if (!batcher)
+			--users;
+	};
+	~BatcherUse() {
+		if (batcher)
+			--users;
+	};
+	AcousticBatcher *get() const {return batcher;};
+};
+
+extern "C" {
+	int GetNumOutNode();
+	void __real_calcDNN2SetLogExt(int t, void *p, int a_dim, float *a_Ot, int a_N, float *a_bjotP);
+	void __real_freeDNN2Child(void *p);
+
+	/**
+	 * @brief	child Laser 의 음향 모델 계산
+	 * @details	SharedScores 가 보관한 프레임이면 복사하고, AcousticBatcher 가 동작 중이고 입력 차원
+	 			(mini_batch * frame_dim)과 출력 노드 수가 같으면 배치로 계산한다.
+	 */
+	void __wrap_calcDNN2SetLogExt(int t, void *p, int a_dim, float *a_Ot, int a_N, float *a_bjotP) {
+		SharedScores *shared = SharedScores::current();
+		if (shared && shared->fetch(t, static_cast<std::size_t>(a_N), a_bjotP))
+			return;
+
+		BatcherUse batcher;
+		if (batcher.get() && batcher.get()->accepts(a_dim, a_N))
+			batcher.get()->step(t, p, a_Ot, a_bjotP);
+		else
+			__real_calcDNN2SetLogExt(t, p, a_dim, a_Ot, a_N, a_bjotP);
+
+		if (shared)
+			shared->store(t, static_cast<std::size_t>(a_N), a_bjotP);
+	}
+
+	void __wrap_freeDNN2Child(void *p) {
+		{
+			BatcherUse batcher;
+			if (batcher.get())
+				batcher.get()->release(p);
+		}
+		__real_freeDNN2Child(p);
+	}
+}
+
+AcousticBatcher::AcousticBatcher(const BatcherOptions &batcher_options) : options(batcher_options) {
+}
+
+AcousticBatcher::~AcousticBatcher() {
+	if (models.empty())
+		return;
+	for (std::size_t i = 0; i + 1 < models.size(); ++i) {
+		if (models[i])
+			__real_freeDNN2Child(models[i]);
+	}
+	if (models.back())
+		freeDNN2(models.back());
+}
+
+/**
+ * @brief		배치 처리 시작
+ * @details		max_streams 를 넘는 가장 작은 2의 거듭제곱까지, 스트림 수별 모델을 만든다.
+ 				가장 큰 모델만 가중치를 읽고 나머지는 그 child 로 만든다.
+ * @date		2026. 10. 17. 18:12:40
+ * @param[in]	batcher_options	배치 설정
+ * @return		모델을 만들지 못하면 false
+ */
+bool AcousticBatcher::start(const BatcherOptions &batcher_options) {
+	if (!batcher_options.max_streams || instance.load())
+		return false;
+
+	AcousticBatcher *batcher = new AcousticBatcher(batcher_options);
+	if (!batcher->load()) {
+		delete batcher;
+		return false;
+	}
+	batcher->running = true;
+	batcher->worker = std::thread(&AcousticBatcher::run, batcher);
+	instance.store(batcher);
+	return true;
+}
+
+/**
+ * @brief	배치 처리 종료
+ * @details	child Laser 를 모두 해제한 뒤 호출한다. 인스턴스를 가져간 쓰레드가 모두 끝날 때까지 기다리며,
+ 			대기 중인 요청은 계산한 뒤 종료한다.
+ */
+void AcousticBatcher::stop() {
+	AcousticBatcher *batcher = instance.exchange(NULL);
+	if (!batcher)
+		return;
+	// 새 요청은 인스턴스를 보지 못하므로, 사용 중인 쓰레드만 끝나면 됨 (배치 쓰레드는 계속 동작)
+	while (users.load())
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	{
+		std::lock_guard<std::mutex> guard(batcher->lock);
+		batcher->running = false;
+	}
+	batcher->pending.notify_all();
+	batcher->worker.join();
+	delete batcher;
+}
+
+AcousticBatcher *AcousticBatcher::getInstance() {
+	return instance.load(std::memory_order_acquire);
+}
+
+bool AcousticBatcher::load() {
+	std::size_t levels = 0;
+	while ((1UL << levels) < options.max_streams)
+		++levels;
+	models.assign(levels + 1, NULL);
+
+	void *model = createDNN2Ext(0, static_cast<int>(options.idGPU),
+								const_cast<char *>(options.dnn_file.c_str()),
+								const_cast<char *>(options.norm_file.c_str()),
+								const_cast<char *>(options.prior_file.c_str()),
+								static_cast<float>(options.prior_weight),
+								static_cast<int>(options.mini_batch << levels));
+	if (!model)
+		return false;
+	models.back() = model;
+	for (std::size_t i = 0; i < levels; ++i) {
+		models[i] = createDNN2ExtChild(model, 0, static_cast<int>(options.idGPU),
+									   const_cast<char *>(options.dnn_file.c_str()),
+									   const_cast<char *>(options.norm_file.c_str()),
+									   const_cast<char *>(options.prior_file.c_str()),
+									   static_cast<float>(options.prior_weight),
+									   static_cast<int>(options.mini_batch << i));
+		if (!models[i])
+			return false;
+	}
+
+	outputs = static_cast<std::size_t>(GetNumOutNode());
+	features.assign((options.mini_batch << levels) * options.frame_dim, 0.0f);
+	return outputs > 0;
+}
+
+/**
+ * @brief		child DNN 의 프레임 t 사후 확률
+ * @details		미니배치의 첫 프레임이면 배치에 넣고 계산될 때까지 기다린다.
+ * @param[in]	t			프레임 위치
+ * @param[in]	stream		child DNN
+ * @param[in]	input		미니배치 특징 벡터 (mini_batch * frame_dim, accepts() 로 확인)
+ * @param[out]	posteriors	프레임 t 의 사후 확률 (출력 노드 수)
+ */
+void AcousticBatcher::step(const int t, void *stream, const float *input, float *posteriors) {
+	const std::size_t row = static_cast<std::size_t>(t) % options.mini_batch;
+	std::vector<float> *rows;
+	{
+		std::lock_guard<std::mutex> guard(stream_lock);
+		rows = &streams[stream];
+	}
+	if (row == 0) {
+		rows->resize(options.mini_batch * outputs);
+		score(input, rows->data());
+	}
+	if (rows->empty()) {
+		std::fill(posteriors, posteriors + outputs, 0.0f);
+		return;
+	}
+	std::copy(rows->begin() + row * outputs, rows->begin() + (row + 1) * outputs, posteriors);
+}
+
+/**
+ * @brief	child DNN 해제 시 보관한 결과 삭제
+ */
+void AcousticBatcher::release(void *stream) {
+	std::lock_guard<std::mutex> guard(stream_lock);
+	streams.erase(stream);
+}
+
+/**
+ * @brief		미니배치 하나를 배치에 넣고 계산될 때까지 대기
+ */
+void AcousticBatcher::score(const float *input, float *posteriors) {
+	Request request = {input, posteriors, std::chrono::steady_clock::now(), false};
+	std::unique_lock<std::mutex> guard(lock);
+	queue.push_back(&request);
+	pending.notify_one();
+	finished.wait(guard, [&request]() {return request.done;});
+}
+
+/**
+ * @brief	배치 쓰레드
+ * @details	max_streams 만큼 모이거나 가장 먼저 온 요청의 대기 시간이 options.wait 를 넘으면 계산한다.
+ */
+void AcousticBatcher::run() {
+	std::vector<Request *> batch;
+	std::unique_lock<std::mutex> guard(lock);
+	while (running || !queue.empty()) {
+		if (queue.empty()) {
+			pending.wait(guard);
+			continue;
+		}
+
+		const std::chrono::steady_clock::time_point deadline = queue.front()->arrival + options.wait;
+		while (running && queue.size() < options.max_streams && std::chrono::steady_clock::now() < deadline)
+			pending.wait_until(guard, deadline);
+
+		const std::size_t count = std::min(queue.size(), options.max_streams);
+		batch.assign(queue.begin(), queue.begin() + count);
+		queue.erase(queue.begin(), queue.begin() + count);
+
+		guard.unlock();
+		compute(batch);
+		guard.lock();
+
+		for (auto request : batch)
+			request->done = true;
+		finished.notify_all();
+	}
+}
+
+/**
+ * @brief		모은 미니배치를 이어 붙여 한 번에 계산
+ * @details		요청 수 이상인 가장 작은 모델을 사용한다. 남는 자리는 이전 입력이 남아 있지만
+ 				프레임끼리 독립이므로 결과에 영향이 없다.
+ */
+void AcousticBatcher::compute(std::vector<Request *> &batch) {
+	std::size_t level = 0;
+	while ((1UL << level) < batch.size())
+		++level;
+
+	const std::size_t block = options.mini_batch * options.frame_dim;
+	for (std::size_t i = 0; i < batch.size(); ++i)
+		std::copy(batch[i]->features, batch[i]->features + block, features.begin() + i * block);
+
+	// 엔진이 미니배치 전체 차원을 넘기는 것과 같이, 모델의 미니배치 (mini_batch << level) 전체 차원을 넘김
+	const int dim = static_cast<int>(block << level);
+	const std::size_t frames = options.mini_batch * batch.size();
+	for (std::size_t t = 0; t < frames; ++t) {
+		Request *request = batch[t / options.mini_batch];
+		__real_calcDNN2SetLogExt(static_cast<int>(t), models[level], dim,
+								 features.data(), static_cast<int>(outputs),
+								 request->posteriors + (t % options.mini_batch) * outputs);
+	}
+}
+
+/**
+ * @brief		현재 쓰레드에서 음향 모델 계산 공유 시작
+ * @date		2026. 10. 17. 21:52:16
+ * @param[in]	a_capacity	lead() 한 번에 탐색하는 최대 프레임 수 (미니배치와 초기화 시 넣는 묵음 프레임 포함)
+ */
+SharedScores::SharedScores(const std::size_t a_capacity)
+	: previous(shared_scores), capacity(a_capacity), frames(a_capacity, -1) {
+	shared_scores = this;
+}
+
+SharedScores::~SharedScores() {
+	shared_scores = previous;
+}
+
+SharedScores *SharedScores::current() {
+	return shared_scores;
+}
+
+/**
+ * @brief		보관한 프레임 t 의 사후 확률 복사
+ * @return		follow() 중이 아니거나 보관하지 않은 프레임이면 false
+ */
+bool SharedScores::fetch(const int t, const std::size_t n, float *posteriors) {
+	if (leading || t < 0 || n != outputs)
+		return false;
+	const std::size_t row = static_cast<std::size_t>(t) % capacity;
+	if (frames[row] != t)
+		return false;
+	std::copy(rows.begin() + row * outputs, rows.begin() + (row + 1) * outputs, posteriors);
+	++hits;
+	return true;
+}
+
+/**
+ * @brief		lead() 중에 계산한 프레임 t 의 사후 확률 보관
+ */
+void SharedScores::store(const int t, const std::size_t n, const float *posteriors) {
+	if (!leading || t < 0)
+		return;
+	if (n != outputs) {
+		outputs = n;
+		rows.assign(capacity * outputs, 0.0f);
+		std::fill(frames.begin(), frames.end(), -1);
+	}
+	const std::size_t row = static_cast<std::size_t>(t) % capacity;
+	frames[row] = t;
+	std::copy(posteriors, posteriors + outputs, rows.begin() + row * outputs);
+}
@@ -0,0 +1,126 @@
+/**
+ * @headerfile	batcher.hpp "batcher.hpp"
+ * @file	batcher.hpp
+ * @brief	여러 스트림의 음향 모델 계산을 묶어서 처리
+ * @details	child Laser 는 탐색 중 미니배치의 첫 프레임에서 calcDNN2SetLogExt() 로 자기 스트림의 미니배치만
+ 			DNN 에 통과시킨다. 링크 시 이 함수를 감싸(-Wl,--wrap) 동시에 들어온 여러 스트림의 미니배치를
+ 			하나의 큰 배치로 모아 한 번에 계산하고, 각 스트림의 탐색에는 자기 프레임의 사후 확률을 돌려준다.
+ 			먼저 들어온 요청이 stt.dnn_batch_wait 보다 오래 기다리지 않도록 모이지 않아도 계산한다.
+ * @date	2026. 10. 17. 18:05:12
+ * @see		batcher.cc
+ */
+#ifndef __ITFACT_VR_BATCHER_H__
+#define __ITFACT_VR_BATCHER_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace itfact {
+	namespace vr {
+		namespace node {
+			/**
+			 * @brief	배치 설정
+			 */
+			struct BatcherOptions {
+				std::size_t max_streams = 0;	///< 한 번에 계산할 최대 스트림 수. 0 이면 사용하지 않음
+				std::chrono::microseconds wait = std::chrono::microseconds(5000);	///< 먼저 온 요청의 최대 대기
+				std::size_t mini_batch = 128;	///< child Laser 의 미니배치 (frame)
+				std::size_t frame_dim = 600;	///< 프레임당 특징 벡터 차원
+				long idGPU = 0;
+				double prior_weight = 0.8;
+				std::string dnn_file;
+				std::string norm_file;
+				std::string prior_file;
+			};
+
+			class AcousticBatcher
+			{
+			private: // Member
+				/// 스트림 하나의 미니배치
+				struct Request {
+					const float *features;
+					float *posteriors;	///< mini_batch * outputs
+					std::chrono::steady_clock::time_point arrival;
+					bool done;
+				};
+
+				BatcherOptions options;
+				std::size_t outputs = 0;		///< 출력 노드 수
+				std::vector<void *> models;		///< models[k] 는 2^k 스트림 분량의 미니배치
+				std::vector<float> features;
+
+				std::mutex lock;
+				std::condition_variable pending;
+				std::condition_variable finished;
+				std::deque<Request *> queue;
+				std::thread worker;
+				bool running = false;
+
+				/// 스트림(child DNN)별 마지막 미니배치의 사후 확률
+				std::unordered_map<void *, std::vector<float>> streams;
+				std::mutex stream_lock;
+
+			public:
+				static bool start(const BatcherOptions &batcher_options);
+				static void stop();
+				static AcousticBatcher *getInstance();
+
+				std::size_t getOutputs() const {return outputs;};
+				/// 배치 모델과 같은 미니배치 차원(a_dim)과 출력 노드 수(a_N)의 요청인지 확인
+				bool accepts(const int a_dim, const int a_N) const {
+					return a_dim > 0 && static_cast<std::size_t>(a_dim) == options.mini_batch * options.frame_dim &&
+						   a_N > 0 && static_cast<std::size_t>(a_N) == outputs;
+				};
+				void step(const int t, void *stream, const float *features, float *posteriors);
+				void release(void *stream);
+
+			private:
+				explicit AcousticBatcher(const BatcherOptions &batcher_options);
+				~AcousticBatcher();
+				bool load();
+				void score(const float *features, float *posteriors);
+				void run();
+				void compute(std::vector<Request *> &batch);
+			};
+
+			/**
+			 * @brief	같은 특징 벡터를 여러 child Laser 로 탐색할 때 음향 모델 계산 공유
+			 * @details	객체가 있는 동안 현재 쓰레드의 calcDNN2SetLogExt() 는 lead() 이후 계산한 사후 확률을
+			 			프레임 위치별로 보관하고, follow() 이후에는 보관한 프레임을 계산 없이 복사한다.
+			 			같은 프레임 구간을 lead() 로 먼저 탐색한 뒤 나머지 child Laser 가 follow() 로 탐색해야 한다.
+			 */
+			class SharedScores : private boost::noncopyable
+			{
+			private: // Member
+				SharedScores *previous;
+				std::size_t capacity;			///< 보관할 프레임 수
+				std::size_t outputs = 0;
+				std::vector<long> frames;		///< 행별 프레임 위치. -1 이면 비어 있음
+				std::vector<float> rows;
+				bool leading = true;
+				std::size_t hits = 0;
+
+			public:
+				explicit SharedScores(const std::size_t a_capacity);
+				~SharedScores();
+				static SharedScores *current();
+
+				void lead() {leading = true;};
+				void follow() {leading = false;};
+				bool fetch(const int t, const std::size_t n, float *posteriors);
+				void store(const int t, const std::size_t n, const float *posteriors);
+				std::size_t getHits() const {return hits;};
+			};
+		}
+	}
+}
+
+#endif /* __ITFACT_VR_BATCHER_H__ */
@@ -0,0 +1,27 @@
+/**
+ * @file	main.cc
+ * @brief	VR Server 실행 
+ * @details	vr_bench 가 VR Server 의 나머지 소스를 그대로 링크할 수 있도록 main() 만 분리 
+ * @author	Kijeong Khil (kjkhil@itfact.co.kr)
+ * @date	2016. 06. 17. 17:32:24
+ * @see		vr_server.cc
+ */
+#include <cstdio>
+
+#include "vr.hpp"
+
+using namespace itfact::vr::node;
+
+/**
+ */
+int main(const int argc, char const *argv[]) {
+	try {
+		VRServer server(argc, argv);
+		server.initialize();
+	} catch (std::exception &e) {
+		perror(e.what());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
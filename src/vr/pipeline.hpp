@@ -0,0 +1,85 @@
+/**
+ * @headerfile	pipeline.hpp "pipeline.hpp"
+ * @file	pipeline.hpp
+ * @brief	작업 내 단계 간 전달
+ * @details	생산자와 소비자가 각각 하나인 고정 크기 링 버퍼.
+ 			가득 차거나 비어 있으면 잠시 양보한 뒤 대기하므로 두 단계가 서로 속도를 맞춘다.
+ * @date	2026. 10. 17. 13:05:12
+ * @see		vr.cc
+ */
+#ifndef __ITFACT_VR_PIPELINE_H__
+#define __ITFACT_VR_PIPELINE_H__
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace itfact {
+	namespace vr {
+		namespace node {
+			/**
+			 * @brief	Single producer, single consumer ring
+			 */
+			template <typename T>
+			class SpscRing : private boost::noncopyable
+			{
+			private: // Member
+				std::vector<T> slots;
+				std::size_t mask;
+				std::atomic<std::size_t> head;	///< 소비자만 기록
+				char padding[64];				///< head 와 tail 이 같은 캐시 라인에 놓이지 않도록
+				std::atomic<std::size_t> tail;	///< 생산자만 기록
+
+			public:
+				explicit SpscRing(const std::size_t capacity) : head(0), tail(0) {
+					std::size_t size = 1;
+					while (size < capacity)
+						size <<= 1;
+					slots.resize(size);
+					mask = size - 1;
+				};
+
+				bool push(const T &value) {
+					std::size_t position = tail.load(std::memory_order_relaxed);
+					if (position - head.load(std::memory_order_acquire) == slots.size())
+						return false;
+					slots[position & mask] = value;
+					tail.store(position + 1, std::memory_order_release);
+					return true;
+				};
+
+				bool pop(T &value) {
+					std::size_t position = head.load(std::memory_order_relaxed);
+					if (position == tail.load(std::memory_order_acquire))
+						return false;
+					value = slots[position & mask];
+					head.store(position + 1, std::memory_order_release);
+					return true;
+				};
+			};
+
+			/**
+			 * @brief		op 가 성공할 때까지 대기
+			 * @details		처음 몇 번은 양보만 하고, 이후에는 짧게 잠든다.
+			 * @return		abort 가 설정되면 false
+			 */
+			template <typename Operation>
+			inline bool wait_until(Operation op, const std::atomic<bool> &abort) {
+				for (unsigned int spin = 0; !op(); ++spin) {
+					if (abort.load(std::memory_order_relaxed))
+						return false;
+					if (spin < 64)
+						std::this_thread::yield();
+					else
+						std::this_thread::sleep_for(std::chrono::microseconds(50));
+				}
+				return true;
+			}
+		}
+	}
+}
+
+#endif /* __ITFACT_VR_PIPELINE_H__ */
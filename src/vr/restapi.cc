@@ -36,7 +36,8 @@ static struct {
 	.connection_timeout = 10000
 };
 
-RestApi::RestApi(const itfact::common::Configuration *server_config, log4cpp::Category *logger) {
+RestApi::RestApi(const itfact::common::Configuration *server_config, log4cpp::Category *logger,
+				 itfact::worker::WorkerDaemon *daemon) {
 	config = server_config;
 	req_logger = logger;
 	service_name = config->getConfig("api.service", default_config.service_name.c_str());
@@ -44,7 +45,7 @@ RestApi::RestApi(const itfact::common::Configuration *server_config, log4cpp::Ca
 
 	// 각 버전 등록 
 	try {
-		versions["v1.0"] = std::make_shared<v1::RestApiV1>(logger);
+		versions["v1.0"] = std::make_shared<v1::RestApiV1>(logger, daemon);
 	} catch (std::exception &e) {
 		req_logger->warn("Cannot register: v1.0: %s", e.what());
 	}
@@ -182,12 +183,13 @@ int RestApi::request_handler(void *cls,
  * @param[in]	connection	연결 정보 
  * @param[in]	body		응답 메시지 
  * @param[in]	body_size	응답 메시지 크기 
+ * @param[in]	content_type	Content-Type 
  * @retval		true	전송 성공 
  * @retval		false	전송 실패 
 * @see			
  */
 bool RestApi::response(struct MHD_Connection *connection,
-					  const char *body, size_t body_size) {
+					  const char *body, size_t body_size, const char *content_type) {
 	req_logger->debug("Response < %s", body);
 	struct MHD_Response *resp =
 		MHD_create_response_from_buffer(body_size, (void *) body, MHD_RESPMEM_MUST_COPY);
@@ -195,7 +197,7 @@ bool RestApi::response(struct MHD_Connection *connection,
 		return false;
 
 	std::shared_ptr<struct MHD_Response> res(resp, MHD_destroy_response);
-	if (MHD_add_response_header(res.get(), "Content-Type", "application/json; charset=utf-8") != MHD_YES)
+	if (MHD_add_response_header(res.get(), "Content-Type", content_type) != MHD_YES)
 		return false;
 
 	int rc = MHD_queue_response(connection, MHD_HTTP_OK, res.get());
@@ -16,6 +16,7 @@
 #include <boost/noncopyable.hpp>
 
 #include "configuration.hpp"
+#include "worker.hpp"
 
 #ifndef ITFACT_RESTAPI_HPP
 #define ITFACT_RESTAPI_HPP
@@ -65,7 +66,8 @@ namespace itfact {
 				std::map<std::string, std::shared_ptr<Version>> versions;
 
 			public:
-				RestApi(const itfact::common::Configuration *server_config, log4cpp::Category *logger);
+				RestApi(const itfact::common::Configuration *server_config, log4cpp::Category *logger,
+						itfact::worker::WorkerDaemon *daemon = NULL);
 				~RestApi();
 				int start();
 				void stop();
@@ -86,7 +88,8 @@ namespace itfact {
 				std::string getServiceName() {return service_name;};
 
 				static bool response(struct MHD_Connection *connection,
-									const char *body, size_t body_size);
+									const char *body, size_t body_size,
+									const char *content_type = "application/json; charset=utf-8");
 
 				static bool sendBadRequest( struct MHD_Connection *connection,
 											const std::string &detail_message);
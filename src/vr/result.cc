@@ -0,0 +1,221 @@
+/**
+ * @file	result.cc
+ * @brief	Laser 인식 결과 해석과 출력
+ * @details	tokenize_result() 는 줄마다 sscanf("%d %d %s %f") 와 같은 규칙으로 항목을 읽는다.
+ 			format_float() 는 "%.9g" 가 지수 표기를 쓰지 않는 범위(1e-4 이상 1e9 미만)의 값을 정수 연산으로 9 자리 반올림(가까운 짝수)하며,
+ 			나머지는 snprintf("%.9g") 를 쓴다.
+ * @date	2026. 10. 17. 20:44:02
+ * @see		result.hpp
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "result.hpp"
+
+using namespace itfact::vr::node;
+
+namespace {
+	/// 줄바꿈을 뺀 isspace()
+	inline bool is_blank(const char c) {
+		return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+	}
+
+	inline const char *skip_blank(const char *cursor, const char *end) {
+		while (cursor < end && is_blank(*cursor))
+			++cursor;
+		return cursor;
+	}
+
+	/// %d, %lu 와 같이 앞의 공백, 부호, 10진수
+	bool parse_long(const char *&cursor, const char *end, long &value) {
+		const char *p = skip_blank(cursor, end);
+		bool negative = false;
+		if (p < end && (*p == '-' || *p == '+'))
+			negative = (*p++ == '-');
+		if (p >= end || *p < '0' || *p > '9')
+			return false;
+		unsigned long number = 0;
+		for (; p < end && *p >= '0' && *p <= '9'; ++p)
+			number = number * 10 + static_cast<unsigned long>(*p - '0');
+		value = static_cast<long>(negative ? 0 - number : number);
+		cursor = p;
+		return true;
+	}
+
+	const uint64_t POW10[] = {
+		1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+		1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL
+	};
+
+	/**
+	 * @brief	value * 10^k 를 가까운 짝수로 반올림
+	 * @details	value = mantissa * 2^exponent 이고 mantissa < 2^24, k <= 13 이므로 곱은 64 비트에 들어간다.
+	 */
+	uint64_t scale_round(const uint32_t mantissa, const int exponent, const int k) {
+		uint64_t number = static_cast<uint64_t>(mantissa) * POW10[k];
+		if (exponent >= 0)
+			return number << exponent;
+		const int shift = -exponent;
+		if (shift >= 64)
+			return 0;
+		uint64_t quotient = number >> shift;
+		uint64_t remainder = number & ((1ULL << shift) - 1);
+		uint64_t half = 1ULL << (shift - 1);
+		if (remainder > half || (remainder == half && (quotient & 1)))
+			++quotient;
+		return quotient;
+	}
+}
+
+/**
+ * @brief		인식 결과를 줄 단위로 나눔
+ * @details		항목을 하나도 읽지 못한 줄은 넣지 않는다.
+ * @param[in]	result	getWBAdjustedResultSLaser() 결과 (NUL 종료)
+ * @param[out]	words	결과 줄 (기존 내용은 지움)
+ */
+void itfact::vr::node::tokenize_result(const char *result, std::vector<ResultWord> &words) {
+	words.clear();
+	const char *line = result;
+	while (*line) {
+		const char *next = std::strchr(line, '\n');
+		if (!next)
+			next = line + std::strlen(line);
+
+		ResultWord word = {0, 0, NULL, 0, 0.0f, 0};
+		const char *cursor = line;
+		if (parse_long(cursor, next, word.start)) {
+			++word.fields;
+			if (parse_long(cursor, next, word.end)) {
+				++word.fields;
+				cursor = skip_blank(cursor, next);
+				if (cursor < next) {
+					word.word = cursor;
+					while (cursor < next && !is_blank(*cursor))
+						++cursor;
+					word.length = static_cast<std::size_t>(cursor - word.word);
+					++word.fields;
+
+					cursor = skip_blank(cursor, next);
+					char *parsed;
+					if (cursor < next) {
+						word.like = std::strtof(cursor, &parsed);
+						if (parsed != cursor && parsed <= next)
+							++word.fields;
+					}
+				}
+			}
+			words.push_back(word);
+		}
+		line = *next ? next + 1 : next;
+	}
+}
+
+/**
+ * @brief		10진수 출력
+ * @param[out]	out		버퍼 (FORMAT_BUFFER_SIZE 이상)
+ * @return		출력한 문자열의 끝 (NUL 을 붙이지 않음)
+ */
+char *itfact::vr::node::format_integer(char *out, unsigned long value) {
+	char digits[24];
+	char *p = digits + sizeof(digits);
+	do {
+		*--p = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value);
+	const std::size_t length = static_cast<std::size_t>(digits + sizeof(digits) - p);
+	std::memcpy(out, p, length);
+	return out + length;
+}
+
+/**
+ * @brief		"%.9g" 와 같은 float 출력
+ * @param[out]	out		버퍼 (FORMAT_BUFFER_SIZE 이상)
+ * @param[in]	value	값
+ * @return		출력한 문자열의 끝 (NUL 을 붙이지 않음)
+ */
+char *itfact::vr::node::format_float(char *out, const float value) {
+	const int PRECISION = 9;
+	const float magnitude = std::fabs(value);
+	if (!(magnitude >= 1e-5f && magnitude < 1e10f)) {
+		if (value == 0.0f) {
+			char *p = out;
+			if (std::signbit(value))
+				*p++ = '-';
+			*p++ = '0';
+			return p;
+		}
+		return out + std::snprintf(out, FORMAT_BUFFER_SIZE, "%.9g", static_cast<double>(value));
+	}
+
+	uint32_t bits;
+	std::memcpy(&bits, &magnitude, sizeof(bits));
+	const uint32_t mantissa = (bits & 0x7fffff) | 0x800000;
+	const int exponent = static_cast<int>(bits >> 23) - 150;
+
+	// 10^8 <= digits < 10^9 가 되는 십진 지수. 반올림으로 자리가 올라가면 (9.999999999 -> 10.0000000) 다음 지수
+	int decimal = ((exponent + 23) * 1233) >> 12;	// floor(log2 * log10(2)), 많아야 1 작다
+	uint64_t digits = 0;
+	for (int retry = 0; retry < 4; ++retry) {
+		const int k = PRECISION - 1 - decimal;
+		if (k < 0 || k > 13)
+			break;
+		digits = scale_round(mantissa, exponent, k);
+		if (digits >= POW10[PRECISION])
+			++decimal;
+		else if (digits < POW10[PRECISION - 1])
+			--decimal;
+		else
+			break;
+	}
+	if (digits < POW10[PRECISION - 1] || digits >= POW10[PRECISION] || decimal < -4 || decimal >= PRECISION)
+		return out + std::snprintf(out, FORMAT_BUFFER_SIZE, "%.9g", static_cast<double>(value));
+
+	char text[PRECISION];
+	for (int i = PRECISION - 1; i >= 0; --i) {
+		text[i] = static_cast<char>('0' + digits % 10);
+		digits /= 10;
+	}
+	int used = PRECISION;
+	while (used > 1 && used > decimal + 1 && text[used - 1] == '0')
+		--used;
+
+	char *p = out;
+	if (value < 0)
+		*p++ = '-';
+	if (decimal >= 0) {
+		std::memcpy(p, text, decimal + 1);
+		p += decimal + 1;
+		if (used > decimal + 1) {
+			*p++ = '.';
+			std::memcpy(p, text + decimal + 1, used - decimal - 1);
+			p += used - decimal - 1;
+		}
+	} else {
+		*p++ = '0';
+		*p++ = '.';
+		for (int i = -1; i > decimal; --i)
+			*p++ = '0';
+		std::memcpy(p, text, used);
+		p += used;
+	}
+	return p;
+}
+
+/**
+ * @brief		"시작\t끝\t단어\t우도\n" 한 줄 추가
+ */
+void itfact::vr::node::append_result_line(std::string &buffer, const std::size_t start, const std::size_t end,
+										  const char *word, const std::size_t length, const float like) {
+	char number[FORMAT_BUFFER_SIZE];
+	buffer.append(number, format_integer(number, start));
+	buffer.push_back('\t');
+	buffer.append(number, format_integer(number, end));
+	buffer.push_back('\t');
+	buffer.append(word, length);
+	buffer.push_back('\t');
+	buffer.append(number, format_float(number, like));
+	buffer.push_back('\n');
+}
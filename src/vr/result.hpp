@@ -0,0 +1,47 @@
+/**
+ * @headerfile	result.hpp "result.hpp"
+ * @file	result.hpp
+ * @brief	Laser 인식 결과 해석과 출력
+ * @details	getWBAdjustedResultSLaser() 가 돌려준 "시작 끝 단어 우도" 줄들을 복사 없이 한 번에 나누어
+ 			재사용하는 ResultWord 벡터에 채운다. 단어는 원본 문자열을 가리키므로 다음 Laser 호출 전까지만 유효하다.
+ 			숫자 출력은 boost::lexical_cast 와 같은 문자열(정수는 10진수, float 는 "%.9g")을 만든다.
+ * @date	2026. 10. 17. 20:44:02
+ * @see		result.cc
+ */
+#ifndef __ITFACT_VR_RESULT_H__
+#define __ITFACT_VR_RESULT_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace itfact {
+	namespace vr {
+		namespace node {
+			/**
+			 * @brief	결과 한 줄
+			 * @details	fields 는 sscanf("%d %d %s %f") 가 돌려줄 항목 수와 같고, 읽지 못한 항목의 값은 정하지 않는다.
+			 */
+			struct ResultWord {
+				long start;
+				long end;
+				const char *word;
+				std::size_t length;
+				float like;
+				int fields;
+			};
+
+			void tokenize_result(const char *result, std::vector<ResultWord> &words);
+
+			/// format_float() 에 필요한 버퍼 크기
+			const std::size_t FORMAT_BUFFER_SIZE = 32;
+
+			char *format_integer(char *out, unsigned long value);
+			char *format_float(char *out, const float value);
+			void append_result_line(std::string &buffer, const std::size_t start, const std::size_t end,
+									const char *word, const std::size_t length, const float like);
+		}
+	}
+}
+
+#endif /* __ITFACT_VR_RESULT_H__ */
@@ -47,16 +47,14 @@ RealtimeSTT::RealtimeSTT(
 	log4cpp::Category *logger
 ) : mfcc_size(a_mfcc_size), mini_batch(a_mini_batch) {
 	job_log = logger;
-	feature_vector = buffer;
+	feature_vector = FeatureBuffer(buffer);
 	front = frontend;
 	laser = child_laser;
 
 	sil = a_sil;
 	minimum_size = mfcc_size * mini_batch;//80 * mini_batch;
 
-	temp_buffer = (float *) malloc(sizeof(float) * minimum_size);//(short *) malloc(sizeof(short) * minimum_size);
-	if (temp_buffer == NULL)
-		throw std::system_error(ENOMEM, std::system_category());
+	temp_buffer = FeatureArena::make_shared(minimum_size);
 }
 
 /**
@@ -65,8 +63,6 @@ RealtimeSTT::RealtimeSTT(
  * @date		2017. 03. 06. 18:26:10
  */
 RealtimeSTT::~RealtimeSTT() {
-	if (temp_buffer)
-		free(temp_buffer);
 }
 
 /**
@@ -77,6 +73,52 @@ void RealtimeSTT::set_reset_period(const std::size_t period) {
 	reset_period = period;
 }
 
+/**
+ * @brief		쉼에 맞춘 초기화 설정
+ * @details		탐색한 프레임이 period 를 넘으면 pause_frames 이상의 쉼에서 결과를 확정하고 초기화한다.
+ * @date		2026. 10. 17. 20:21:37
+ * @param[in]	period			프레임 수. 0 이면 reset_period 에서만 초기화
+ * @param[in]	vad				음성 판정 설정
+ * @param[in]	pause_frames	쉼으로 볼 비음성 프레임 수
+ */
+void RealtimeSTT::set_soft_reset(const std::size_t period, const VadOptions &vad, const std::size_t pause_frames) {
+	reset_soft_period = period;
+	pause.reset(period ? new PauseDetector(vad, pause_frames) : NULL);
+}
+
+/**
+ * @brief		입력 형식 설정
+ * @details		8kHz 단일 채널이 아니면 블록마다 PcmConverter 로 변환한다.
+ * @date		2026. 10. 17. 17:41:30
+ * @param[in]	sample_rate	입력 표본화율 (Hz)
+ * @param[in]	channels	입력 채널 수 (1 또는 2)
+ * @exception	std::invalid_argument	지원하지 않는 입력인 경우
+ */
+void RealtimeSTT::set_input_format(const uint32_t sample_rate, const std::size_t channels) {
+	converter.reset(new PcmConverter(sample_rate, channels));
+	if (converter->passthrough())
+		converter.reset();
+}
+
+/**
+ * @brief		수신한 블록을 8kHz 단일 채널로 변환
+ * @details		변환기는 채널이 유지되는 동안 필터 상태를 보관하므로 블록 경계와 관계없이 이어진다.
+ * @date		2026. 10. 17. 17:43:02
+ * @param[both]	buffer		녹취 데이터. 변환하면 내부 버퍼를 가리킨다
+ * @param[both]	buffer_len	녹취 데이터 길이 
+ * @param[in]	is_last		마지막 패킷 여부. 필터에 남은 샘플까지 출력한다
+ */
+void RealtimeSTT::convert(const short *&buffer, std::size_t &buffer_len, const bool is_last) {
+	if (!converter)
+		return;
+	converted.clear();
+	converter->process(buffer, buffer_len, converted);
+	if (is_last)
+		converter->flush(converted);
+	buffer = converted.data();
+	buffer_len = converted.size();
+}
+
 /**
  * @brief		Speech to text
  * @author		Youngsoo Min (ysmin@itfact.co.kr)
@@ -208,6 +250,8 @@ int RealtimeSTT::stt(
 #else
 	resetSLaser(laser.get()); 
 	resetLFrontEnd(front.get());	
+	if (pause)
+		pause->reset();
 
 	// 녹취 파일을 읽어가며 처리
 	std::size_t read_size = 80 * mini_batch;
@@ -222,20 +266,21 @@ int RealtimeSTT::stt(
 		if (rsize > remain)
 			rsize = remain;
 
-		rc = stepFrameLFrontEnd(front.get(), rsize, const_cast<short *>(&buffer[offset]), &fsize, temp_buffer);
+		rc = stepFrameLFrontEnd(front.get(), rsize, const_cast<short *>(&buffer[offset]), &fsize, temp_buffer.get());
+		if (pause)
+			pause->feed(&buffer[offset], rsize);
 		job_log->debug("[0x%X] stepFrameLFrontEnd(0x%x), read: %d, fsize: %d" LOG_FMT,
 						THREAD_ID, rc, rsize, fsize, LOG_INFO);
 		if (fsize <= 0)
 			continue;
 
 		for (i = 0; i < 15; ++i)
-			memcpy(feature_vector.get() + i * mfcc_size, temp_buffer, sizeof(float) * mfcc_size);
-		memcpy(feature_vector.get() + i * mfcc_size, temp_buffer, sizeof(float) * fsize);
+			memcpy(feature_vector.get() + i * mfcc_size, temp_buffer.get(), sizeof(float) * mfcc_size);
+		memcpy(feature_vector.get() + i * mfcc_size, temp_buffer.get(), sizeof(float) * fsize);
 		fsize = fsize + i * mfcc_size;
 
 		std::size_t nf = fsize / mfcc_size;
-		if (nf < mini_batch)
-			memcpy(feature_vector.get() + nf * mfcc_size, sil, sizeof(float) * mfcc_size * (mini_batch - nf));
+		feature_vector.pad(nf, sil, mfcc_size, mini_batch);
 
 		for (i = 0; i < nf; ++i) {
 			// 특징 벡터의 차원 값을 추가적으로 사용하여 프레임 기반의 탐색을 수행 (feature_dim = 128 * 600)
@@ -259,14 +304,15 @@ int RealtimeSTT::stt(
 
 		// 음성 신호로부터 특징 벡터 출력
 		rc = stepFrameLFrontEnd(front.get(), rsize, const_cast<short *>(&buffer[offset]), &fsize,feature_vector.get());
+		if (pause)
+			pause->feed(&buffer[offset], rsize);
 		if (rc) job_log->debug("[0x%X] stepFrameLFrontEnd(0x%x), read: %d, fsize: %d" LOG_FMT,
 								THREAD_ID, rc, rsize, fsize, LOG_INFO);
 		if (fsize <= 0)
 			continue;
 
 		std::size_t nf = fsize / mfcc_size;
-		if (nf < mini_batch)
-			memcpy(feature_vector.get() + nf * mfcc_size, sil, sizeof(float) * mfcc_size * (mini_batch - nf));
+		feature_vector.pad(nf, sil, mfcc_size, mini_batch);
 
 		for (i = 0; i < nf; ++i) {
 			// 특징 벡터의 차원 값을 추가적으로 사용하여 프레임 기반의 탐색을 수행 (feature_dim = 128 * 600)
@@ -275,7 +321,7 @@ int RealtimeSTT::stt(
 		}
 		index += nf;
 
-		if (index > reset_period) {
+		if (index > reset_period || (pause && index > reset_soft_period && pause->paused())) {
 			if (get_final_result(laser.get(), index, last_position, feature_dim, mfcc_size, sil, result) != EXIT_SUCCESS)
 				continue;
 
@@ -0,0 +1,86 @@
+/**
+ * @file	commands.cc
+ * @brief	Request Commands v1.0
+ * @details	서버 제어 명령\n
+ 			POST /vr/v1.0/command/drain	처리중인 작업을 마친 후 종료\n
+ 			GET  /vr/v1.0/command/drain	종료 대기 상태 조회
+ * @date	2026. 10. 16. 15:31:08
+ * @see		restapi_v1.cc
+ */
+#include <string>
+
+#include "restapi_v1.hpp"
+
+using namespace itfact::vr::node::v1;
+
+const std::string Commands::resource_name = "command";
+
+bool Commands::equals(const std::string *resource) {
+	if (resource->compare(resource_name) == 0)
+		return true;
+	return false;
+}
+
+/**
+ * @brief		Request 처리
+ * @date		2026. 10. 16. 15:32:47
+ * @param[in]	id	명령
+ * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
+ 				Otherwise,
+ 				a negative error code is returned indicating what went wrong.
+ */
+int Commands::request(const std::string *id,
+			const char *upload_data, size_t *upload_data_size, void **con_cls) {
+	logger->debug("[%s] in Commands resource", job_name);
+
+	if (!id || id->compare("drain") != 0) {
+		logger->error("[%s] Bad request: Unknown command", job_name);
+		RestApi::sendNotFound(connection, "해당하는 명령이 없습니다.");
+		return EXIT_FAILURE;
+	}
+	if (!daemon) {
+		RestApi::sendInternalServerError(connection, "워커가 등록되지 않았습니다.");
+		return EXIT_FAILURE;
+	}
+
+	switch (method) {
+	case HTTP_GET:
+		return getState();
+	case HTTP_POST:
+		return drain();
+	case HTTP_PUT:
+	case HTTP_PATCH:
+	case HTTP_DELETE:
+	default:
+		logger->error("[%s] Unsupported method", job_name);
+		RestApi::sendUnsupportedMethod(connection, "허용되지 않은 메소드입니다.");
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief		종료 대기 시작
+ * @date		2026. 10. 16. 15:35:20
+ */
+int Commands::drain() {
+	logger->info("[%s] Drain requested", job_name);
+	daemon->stop();
+	return getState();
+}
+
+/**
+ * @brief		종료 대기 상태 응답
+ * @date		2026. 10. 16. 15:36:02
+ */
+int Commands::getState() {
+	std::string json("{\"running\": ");
+	json.append(daemon->isRunning() ? "true" : "false");
+	json.append(", \"active_jobs\": ");
+	json.append(std::to_string(daemon->getActiveJobs()));
+	json.append("}");
+
+	if (!RestApi::response(connection, json.c_str(), json.size()))
+		return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
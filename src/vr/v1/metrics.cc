@@ -0,0 +1,42 @@
+/**
+ * @file	metrics.cc
+ * @brief	Request Metrics v1.0
+ * @details	GET /vr/v1.0/metrics	작업 처리 통계 (Prometheus text format)
+ * @date	2026. 10. 16. 17:44:18
+ * @see		restapi_v1.cc
+ */
+#include "metrics.hpp"
+#include "restapi_v1.hpp"
+
+using namespace itfact::vr::node::v1;
+
+const std::string Metrics::resource_name = "metrics";
+
+bool Metrics::equals(const std::string *resource) {
+	if (resource->compare(resource_name) == 0)
+		return true;
+	return false;
+}
+
+/**
+ * @brief		Request 처리
+ * @date		2026. 10. 16. 17:45:02
+ * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
+ 				Otherwise,
+ 				a negative error code is returned indicating what went wrong.
+ */
+int Metrics::request(const std::string *id,
+			const char *upload_data, size_t *upload_data_size, void **con_cls) {
+	logger->debug("[%s] in Metrics resource", job_name);
+
+	if (method != HTTP_GET) {
+		logger->error("[%s] Unsupported method", job_name);
+		RestApi::sendUnsupportedMethod(connection, "허용되지 않은 메소드입니다.");
+		return EXIT_FAILURE;
+	}
+
+	std::string body = itfact::worker::Metrics::expose();
+	if (!RestApi::response(connection, body.c_str(), body.size(), "text/plain; version=0.0.4"))
+		return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
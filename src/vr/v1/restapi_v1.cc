@@ -42,13 +42,14 @@ RestApiV1::handleRequest(const char *job_name,
 
 	req_logger->debug("[%s] Check resource: %s", job_name, resource->c_str());
 	std::shared_ptr<Request> request;
-	if (resource->compare("command") == 0) {
-		req_logger->debug("[%s] Command", job_name);
-		return EXIT_FAILURE;
+	if (Commands::equals(resource)) {
+		request = std::make_shared<Commands>(job_name, connection, method, req_logger, daemon);
 	} else if(Servers::equals(resource)) {
 		request = std::make_shared<Servers>(job_name, connection, method, req_logger);
 	} else if (Waves::equals(resource)) {
 		request = std::make_shared<Waves>(job_name, connection, method, req_logger);
+	} else if (Metrics::equals(resource)) {
+		request = std::make_shared<Metrics>(job_name, connection, method, req_logger);
 	} else {
 		RestApi::sendNotFound(connection, "해당하는 리소스가 없습니다.");
 		return EXIT_FAILURE;
@@ -12,6 +12,7 @@
 #define ITFACT_RESTAPI_V1_0_HPP
 
 #include "../restapi.hpp"
+#include "worker.hpp"
 
 namespace itfact {
 	namespace vr {
@@ -19,8 +20,12 @@ namespace itfact {
 			namespace v1 {
 				class RestApiV1 : public itfact::vr::node::Version
 				{
+				private: // member
+					itfact::worker::WorkerDaemon *daemon;
+
 				public:
-					RestApiV1(log4cpp::Category *logger) : itfact::vr::node::Version(logger) {};
+					RestApiV1(log4cpp::Category *logger, itfact::worker::WorkerDaemon *worker_daemon = NULL)
+						: itfact::vr::node::Version(logger), daemon(worker_daemon) {};
 
 					virtual int
 					handleRequest(const char *job_name,
@@ -72,6 +77,40 @@ namespace itfact {
 				private:
 					// int getWave(const std::string *id, void **con_cls);
 				};
+
+				class Metrics : public Request
+				{
+				private: // member
+					static const std::string resource_name;
+
+				public:
+					Metrics(const char *job_name, struct MHD_Connection *connection,
+							const enum HTTP_METHOD method, log4cpp::Category *logger)
+						: Request(job_name, connection, method, logger) {};
+					int request(const std::string *id,
+								const char *upload_data, size_t *upload_data_size, void **con_cls);
+					static bool equals(const std::string *resource);
+				};
+
+				class Commands : public Request
+				{
+				private: // member
+					static const std::string resource_name;
+					itfact::worker::WorkerDaemon *daemon;
+
+				public:
+					Commands(const char *job_name, struct MHD_Connection *connection,
+							 const enum HTTP_METHOD method, log4cpp::Category *logger,
+							 itfact::worker::WorkerDaemon *worker_daemon)
+						: Request(job_name, connection, method, logger), daemon(worker_daemon) {};
+					int request(const std::string *id,
+								const char *upload_data, size_t *upload_data_size, void **con_cls);
+					static bool equals(const std::string *resource);
+
+				private:
+					int drain();
+					int getState();
+				};
 			}
 		}
 	}
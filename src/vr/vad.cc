@@ -0,0 +1,307 @@
+/**
+ * @file	vad.cc
+ * @brief	음성 구간 검출
+ * @details	프레임 통계는 CPU 가 지원하면 AVX2, 아니면 SSE2 로 계산하며 결과는 스칼라 계산과 같다.
+ * @date	2026. 10. 17. 15:04:18
+ * @see		vr.cc
+ */
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VAD_X86
+#endif
+
+#include "vad.hpp"
+
+using namespace itfact::vr::node;
+
+/**
+ * @brief		남긴 구간 추가
+ * @details		앞 구간과 원본에서 이어지면 하나로 합친다.
+ * @param[in]	original	원본 시작 위치 (샘플)
+ * @param[in]	length		길이 (샘플)
+ */
+void SpeechMap::add(const std::size_t original, const std::size_t length) {
+	if (!length)
+		return;
+	if (!spans.empty() && spans.back().original + spans.back().length == original) {
+		spans.back().length += length;
+	} else {
+		SpeechSpan span = {kept_samples, original, length};
+		spans.push_back(span);
+	}
+	kept_samples += length;
+}
+
+/**
+ * @brief		제거 후 프레임 위치를 원본 프레임 위치로 변환
+ * @details		끝 위치는 마지막 프레임을 기준으로 변환하여 제거된 구간을 건너 늘어나지 않도록 한다.
+ 				남긴 범위를 벗어난 위치(결과에 붙는 묵음 프레임 등)는 마지막 구간에서 이어지는 것으로 본다.
+ * @param[in]	frame	제거 후 프레임 위치
+ * @param[in]	is_end	끝 위치 여부
+ * @return		원본 프레임 위치
+ */
+std::size_t SpeechMap::toOriginal(const std::size_t frame, const bool is_end) const {
+	const std::size_t frame_size = VoiceActivityDetector::FRAME_SIZE;
+	if (spans.empty())
+		return frame;
+	if (is_end && frame > 0)
+		return toOriginal(frame - 1, false) + 1;
+
+	std::size_t sample = frame * frame_size;
+	auto span = std::upper_bound(spans.begin(), spans.end(), sample,
+								 [](const std::size_t value, const SpeechSpan &item) {return value < item.kept;});
+	if (span != spans.begin())
+		--span;
+	return (span->original + (sample - span->kept)) / frame_size;
+}
+
+static void frame_stats_scalar(const short *buffer, const std::size_t frames, uint64_t *energy, uint16_t *crossings) {
+	const std::size_t frame_size = VoiceActivityDetector::FRAME_SIZE;
+	for (std::size_t i = 0; i < frames; ++i) {
+		const short *frame = buffer + i * frame_size;
+		uint64_t sum = 0;
+		uint16_t count = 0;
+		for (std::size_t j = 0; j < frame_size; ++j)
+			sum += static_cast<uint32_t>(frame[j] * frame[j]);
+		for (std::size_t j = 0; j + 1 < frame_size; ++j)
+			count += ((frame[j] ^ frame[j + 1]) < 0);
+		energy[i] = sum;
+		crossings[i] = count;
+	}
+}
+
+#ifdef VAD_X86
+/**
+ * @details	_mm_madd_epi16 의 결과는 두 제곱의 합으로 항상 0 이상이며 2^31 을 넘지 않으므로
+ 			부호 없는 32비트로 보고 64비트로 넓혀 더한다.
+ 			영교차는 앞 64 쌍을 벡터로, 나머지 15 쌍을 스칼라로 센다.
+ */
+__attribute__((target("sse2")))
+static void frame_stats_sse2(const short *buffer, const std::size_t frames, uint64_t *energy, uint16_t *crossings) {
+	const std::size_t frame_size = VoiceActivityDetector::FRAME_SIZE;
+	const __m128i zero = _mm_setzero_si128();
+	for (std::size_t i = 0; i < frames; ++i) {
+		const short *frame = buffer + i * frame_size;
+		__m128i sum = _mm_setzero_si128();
+		for (std::size_t j = 0; j < frame_size; j += 8) {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(frame + j));
+			__m128i squares = _mm_madd_epi16(x, x);
+			sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(squares, zero));
+			sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(squares, zero));
+		}
+		uint64_t lanes[2];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), sum);
+
+		unsigned int count = 0;
+		for (std::size_t j = 0; j < 64; j += 8) {
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(frame + j));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(frame + j + 1));
+			__m128i changed = _mm_srai_epi16(_mm_xor_si128(a, b), 15);
+			count += __builtin_popcount(_mm_movemask_epi8(changed)) / 2;
+		}
+		for (std::size_t j = 64; j + 1 < frame_size; ++j)
+			count += ((frame[j] ^ frame[j + 1]) < 0);
+
+		energy[i] = lanes[0] + lanes[1];
+		crossings[i] = static_cast<uint16_t>(count);
+	}
+}
+
+__attribute__((target("avx2")))
+static void frame_stats_avx2(const short *buffer, const std::size_t frames, uint64_t *energy, uint16_t *crossings) {
+	const std::size_t frame_size = VoiceActivityDetector::FRAME_SIZE;
+	for (std::size_t i = 0; i < frames; ++i) {
+		const short *frame = buffer + i * frame_size;
+		__m256i sum = _mm256_setzero_si256();
+		for (std::size_t j = 0; j < frame_size; j += 16) {
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(frame + j));
+			__m256i squares = _mm256_madd_epi16(x, x);
+			sum = _mm256_add_epi64(sum, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(squares)));
+			sum = _mm256_add_epi64(sum, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(squares, 1)));
+		}
+		uint64_t lanes[4];
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), sum);
+
+		unsigned int count = 0;
+		for (std::size_t j = 0; j < 64; j += 16) {
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(frame + j));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(frame + j + 1));
+			__m256i changed = _mm256_srai_epi16(_mm256_xor_si256(a, b), 15);
+			count += __builtin_popcount(static_cast<unsigned int>(_mm256_movemask_epi8(changed))) / 2;
+		}
+		for (std::size_t j = 64; j + 1 < frame_size; ++j)
+			count += ((frame[j] ^ frame[j + 1]) < 0);
+
+		energy[i] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+		crossings[i] = static_cast<uint16_t>(count);
+	}
+}
+#endif
+
+/**
+ * @brief		프레임별 에너지와 영교차 수
+ * @param[in]	buffer		16bit PCM
+ * @param[in]	frames		프레임 수 (buffer 는 frames * FRAME_SIZE 샘플 이상)
+ * @param[out]	energy		프레임 에너지 (제곱합)
+ * @param[out]	crossings	프레임 내 부호가 바뀐 횟수
+ */
+void VoiceActivityDetector::frame_stats(const short *buffer, const std::size_t frames,
+										uint64_t *energy, uint16_t *crossings) {
+#ifdef VAD_X86
+	static const bool has_avx2 = __builtin_cpu_supports("avx2");
+	static const bool has_sse2 = __builtin_cpu_supports("sse2");
+	if (has_avx2)
+		return frame_stats_avx2(buffer, frames, energy, crossings);
+	if (has_sse2)
+		return frame_stats_sse2(buffer, frames, energy, crossings);
+#endif
+	frame_stats_scalar(buffer, frames, energy, crossings);
+}
+
+/**
+ * @brief		음성 프레임 판정
+ * @details		에너지가 high 이상이거나, 그 절반 이상이면서 영교차 수가 마찰음 범위이면 음성으로 본다.
+ * @param[in]	energy		프레임 에너지
+ * @param[in]	crossings	프레임 영교차 수
+ * @param[in]	high		음성 에너지 기준
+ */
+bool VoiceActivityDetector::is_speech(const uint64_t energy, const uint16_t crossings, const double high) {
+	return energy >= high || (energy >= high / 2 && crossings >= 20 && crossings <= 60);
+}
+
+/**
+ * @brief		음성 구간 검출
+ * @details		잡음 에너지는 프레임 에너지의 하위 10% 값으로 추정한다.
+ 				에너지가 잡음의 ratio 배 이상이거나, 그 절반 이상이면서 영교차 수가 마찰음 범위인 프레임을 음성으로 본다.
+ 				음성 앞뒤로 hangover 만큼 남기고, min_silence 보다 짧은 비음성 구간은 제거하지 않는다.
+ * @param[in]	buffer	16bit PCM
+ * @param[in]	length	샘플 수
+ * @param[out]	map		남긴 구간
+ * @return		제거한 샘플 수
+ */
+std::size_t VoiceActivityDetector::detect(const short *buffer, const std::size_t length, SpeechMap &map) const {
+	map.clear();
+	const std::size_t frames = length / FRAME_SIZE;
+	if (frames <= options.min_silence) {
+		map.add(0, length);
+		return 0;
+	}
+
+	std::vector<uint64_t> energy(frames);
+	std::vector<uint16_t> crossings(frames);
+	frame_stats(buffer, frames, energy.data(), crossings.data());
+
+	std::vector<uint64_t> sorted(energy);
+	std::nth_element(sorted.begin(), sorted.begin() + frames / 10, sorted.end());
+	const double noise = static_cast<double>(std::max<uint64_t>(sorted[frames / 10], 1));
+	const double high = std::max(static_cast<double>(options.min_energy), noise * options.ratio);
+
+	// 음성 프레임 앞뒤로 hangover 만큼 확장
+	std::vector<char> keep(frames, 0);
+	std::size_t keep_until = 0;
+	for (std::size_t i = 0; i < frames; ++i) {
+		bool speech = is_speech(energy[i], crossings[i], high);
+		if (speech) {
+			std::size_t begin = i > options.hangover ? i - options.hangover : 0;
+			std::size_t from = std::min(std::max(begin, keep_until), i);	// keep_until 이전은 이미 남김
+			std::fill(keep.begin() + from, keep.begin() + i + 1, 1);
+			keep_until = std::min(frames, i + options.hangover + 1);
+		} else if (i < keep_until) {
+			keep[i] = 1;
+		}
+	}
+
+	// 짧은 비음성 구간은 남김
+	for (std::size_t i = 0; i < frames;) {
+		std::size_t j = i;
+		while (j < frames && keep[j] == keep[i])
+			++j;
+		if (!keep[i] && j - i < options.min_silence)
+			std::fill(keep.begin() + i, keep.begin() + j, 1);
+		i = j;
+	}
+
+	for (std::size_t i = 0; i < frames;) {
+		std::size_t j = i;
+		while (j < frames && keep[j] == keep[i])
+			++j;
+		if (keep[i])
+			map.add(i * FRAME_SIZE, (j == frames ? length : j * FRAME_SIZE) - i * FRAME_SIZE);
+		i = j;
+	}
+	return length - map.getKeptSamples();
+}
+
+/**
+ * @brief		남긴 구간만 이어 붙임
+ * @param[in]	buffer	원본 PCM
+ * @param[in]	map		detect() 결과
+ * @param[out]	kept	이어 붙인 PCM
+ */
+void VoiceActivityDetector::compact(const short *buffer, const SpeechMap &map, std::vector<short> &kept) {
+	kept.resize(map.getKeptSamples());
+	for (auto &span : map.getSpans())
+		std::copy(buffer + span.original, buffer + span.original + span.length, kept.begin() + span.kept);
+}
+
+/**
+ * @brief		특징 추출에 넣은 PCM 추가
+ * @param[in]	buffer	16bit PCM
+ * @param[in]	length	샘플 수
+ */
+void PauseDetector::feed(const short *buffer, const std::size_t length) {
+	const std::size_t frame_size = VoiceActivityDetector::FRAME_SIZE;
+	std::size_t used = 0;
+	if (!carry.empty()) {
+		used = std::min(frame_size - carry.size(), length);
+		carry.insert(carry.end(), buffer, buffer + used);
+		if (carry.size() < frame_size)
+			return;
+		update(carry.data(), 1);
+		carry.clear();
+	}
+
+	const std::size_t frames = (length - used) / frame_size;
+	update(buffer + used, frames);
+	used += frames * frame_size;
+	carry.assign(buffer + used, buffer + length);
+}
+
+void PauseDetector::reset() {
+	std::fill(minima.begin(), minima.end(), UINT64_MAX);
+	block_min = UINT64_MAX;
+	block_frames = 0;
+	blocks = 0;
+	silent = 0;
+	carry.clear();
+}
+
+/**
+ * @details		현재 블록까지 포함한 최솟값을 잡음으로 보므로, 잡음이 커지면 NOISE_BLOCKS 초 뒤에 따라간다.
+ */
+void PauseDetector::update(const short *buffer, const std::size_t frames) {
+	if (!frames)
+		return;
+	energy.resize(frames);
+	crossings.resize(frames);
+	VoiceActivityDetector::frame_stats(buffer, frames, energy.data(), crossings.data());
+
+	for (std::size_t i = 0; i < frames; ++i) {
+		block_min = std::min(block_min, energy[i]);
+		uint64_t noise = std::min(block_min, *std::min_element(minima.begin(), minima.end()));
+		const double high = std::max(static_cast<double>(options.min_energy),
+									 static_cast<double>(std::max<uint64_t>(noise, 1)) * options.ratio);
+		if (VoiceActivityDetector::is_speech(energy[i], crossings[i], high))
+			silent = 0;
+		else
+			++silent;
+
+		if (++block_frames == BLOCK_FRAMES) {
+			minima[blocks++ % NOISE_BLOCKS] = block_min;
+			block_min = UINT64_MAX;
+			block_frames = 0;
+		}
+	}
+}
@@ -0,0 +1,113 @@
+/**
+ * @headerfile	vad.hpp "vad.hpp"
+ * @file	vad.hpp
+ * @brief	음성 구간 검출
+ * @details	10ms 프레임의 에너지와 영교차 수로 비음성 구간을 찾아 특징 추출 전에 제거한다.
+ 			SpeechMap 은 남긴 샘플과 원본 위치의 대응을 보관하여 인식 결과의 시간을 원본 기준으로 되돌린다.
+ * @date	2026. 10. 17. 15:02:40
+ * @see		vad.cc
+ */
+#ifndef __ITFACT_VR_VAD_H__
+#define __ITFACT_VR_VAD_H__
+
+#include <cstdint>
+#include <vector>
+
+namespace itfact {
+	namespace vr {
+		namespace node {
+			/**
+			 * @brief	남긴 구간 (샘플 단위)
+			 */
+			struct SpeechSpan {
+				std::size_t kept;		///< 제거 후 시작 위치
+				std::size_t original;	///< 원본 시작 위치
+				std::size_t length;
+			};
+
+			/**
+			 * @brief	제거 후 위치와 원본 위치의 대응
+			 */
+			class SpeechMap
+			{
+			private: // Member
+				std::vector<SpeechSpan> spans;
+				std::size_t kept_samples = 0;
+
+			public:
+				void clear() {spans.clear(); kept_samples = 0;};
+				void add(const std::size_t original, const std::size_t length);
+				bool empty() const {return spans.empty();};
+				std::size_t getKeptSamples() const {return kept_samples;};
+				const std::vector<SpeechSpan> &getSpans() const {return spans;};
+				std::size_t toOriginal(const std::size_t frame, const bool is_end) const;
+			};
+
+			/**
+			 * @brief	음성 구간 검출 설정
+			 */
+			struct VadOptions {
+				bool enable = false;
+				std::size_t min_silence = 50;	///< 제거할 최소 비음성 길이 (frame)
+				std::size_t hangover = 20;		///< 음성 앞뒤로 남길 길이 (frame)
+				double ratio = 4.0;				///< 잡음 에너지 대비 음성 판정 배율
+				uint64_t min_energy = 80 * 100 * 100;	///< 프레임 에너지 하한 (진폭 약 100)
+			};
+
+			class VoiceActivityDetector
+			{
+			public: // const
+				static const std::size_t FRAME_SIZE = 80;	///< 8kHz, 10ms
+
+			private: // Member
+				VadOptions options;
+
+			public:
+				explicit VoiceActivityDetector(const VadOptions &vad_options) : options(vad_options) {};
+
+				std::size_t detect(const short *buffer, const std::size_t length, SpeechMap &map) const;
+				static void compact(const short *buffer, const SpeechMap &map, std::vector<short> &kept);
+				static void frame_stats(const short *buffer, const std::size_t frames,
+										uint64_t *energy, uint16_t *crossings);
+				static bool is_speech(const uint64_t energy, const uint16_t crossings, const double high);
+			};
+
+			/**
+			 * @brief	쉼 검출
+			 * @details	특징 추출에 넣는 순서대로 PCM 을 받아, 마지막 min_pause 프레임이 모두 비음성인지 알려준다.
+			 			녹취 전체를 볼 수 없으므로 잡음 에너지는 최근 NOISE_BLOCKS 초 동안의 프레임 에너지 최솟값으로 추정한다.
+			 */
+			class PauseDetector
+			{
+			public: // const
+				static const std::size_t BLOCK_FRAMES = 100;	///< 1초
+				static const std::size_t NOISE_BLOCKS = 10;
+
+			private: // Member
+				VadOptions options;
+				std::size_t min_pause;		///< frame
+				std::vector<uint64_t> minima;	///< 지난 블록별 최솟값 (링)
+				uint64_t block_min = UINT64_MAX;
+				std::size_t block_frames = 0;
+				std::size_t blocks = 0;
+				std::size_t silent = 0;		///< 이어진 비음성 프레임 수
+				std::vector<short> carry;	///< 프레임에 못 미치는 나머지
+				std::vector<uint64_t> energy;
+				std::vector<uint16_t> crossings;
+
+			public:
+				PauseDetector(const VadOptions &vad_options, const std::size_t pause_frames)
+					: options(vad_options), min_pause(pause_frames), minima(NOISE_BLOCKS, UINT64_MAX) {};
+
+				void feed(const short *buffer, const std::size_t length);
+				bool paused() const {return min_pause && silent >= min_pause;};
+				void reset();
+
+			private:
+				void update(const short *buffer, const std::size_t frames);
+			};
+		}
+	}
+}
+
+#endif /* __ITFACT_VR_VAD_H__ */
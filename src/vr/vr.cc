@@ -9,6 +9,10 @@
 #include <cstdlib>
 #include <cstring>
 #include <cerrno>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <stdexcept>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -17,6 +21,10 @@
 #include "ETRIPP.h"
 
 #include "vr.hpp"
+#include "pipeline.hpp"
+#include "audio.hpp"
+#include "batcher.hpp"
+#include "result.hpp"
 
 using namespace itfact::vr::node;
 
@@ -26,6 +34,48 @@ using namespace itfact::vr::node;
 
 static log4cpp::Category *job_log = NULL;
 
+#ifndef DNN_CPU_ONLY
+extern "C" int cudaGetDeviceCount(int *count);
+#endif
+
+/**
+ * @brief	작업 단위 단계별 처리 시간 
+ * @details	프레임마다 기록하면 히스토그램이 의미가 없으므로 작업 동안 누적한 뒤 소멸 시 한 번 기록한다.
+ */
+class StageTimes : private boost::noncopyable
+{
+private: // Member
+	std::chrono::steady_clock::duration elapsed[STAGE_MAX];
+	bool used[STAGE_MAX];
+	std::chrono::steady_clock::time_point begin;
+	std::size_t frames = 0;
+
+public:
+	StageTimes() {
+		for (std::size_t i = 0; i < STAGE_MAX; ++i) {
+			elapsed[i] = std::chrono::steady_clock::duration::zero();
+			used[i] = false;
+		}
+	};
+	~StageTimes() {
+		for (std::size_t i = 0; i < STAGE_MAX; ++i) {
+			if (used[i])
+				Metrics::observe(static_cast<enum METRIC_STAGE>(i),
+								 std::chrono::duration<double>(elapsed[i]).count());
+		}
+		if (frames)
+			Metrics::add(COUNTER_FRAMES, frames);
+	};
+
+	void start() {begin = std::chrono::steady_clock::now();};
+	void stop(const enum METRIC_STAGE stage) {
+		elapsed[stage] += std::chrono::steady_clock::now() - begin;
+		used[stage] = true;
+	};
+	void addFrames(const std::size_t count) {frames += count;};
+	std::size_t getFrames() const {return frames;};
+};
+
 static struct {
 	std::string laser_config;
 	std::string sil_dnn;
@@ -42,6 +92,9 @@ static struct {
 	.reset_period = 2000000, // 약 2 GiB 정도 적재  
 };
 
+/// 인식 결과 해석 (쓰레드마다 재사용)
+static thread_local std::vector<ResultWord> result_words;
+
 /**
  * @brief		Handle error
  * @author		Youngsoo Min (ysmin@itfact.co.kr)
@@ -51,6 +104,33 @@ static int errorHandler(int a_errCode, char *a_errMsg) {
 	return a_errCode;
 }
 
+/**
+ * @brief		링크된 DNN 엔진으로 stt.useGPU 를 사용할 수 있는지 확인
+ * @details		libdnn.cpu 로 링크된 경우 GPU 를 사용할 수 없고, libdnn.gpu 로 링크된 경우 stt.idGPU 장치가
+ 				있어야 한다. 엔진 내부에서 실패하기 전에 시작 단계에서 멈춘다.
+ * @date		2026. 10. 17. 18:48:26
+ * @param[in]	useGPU	stt.useGPU
+ * @param[in]	idGPU	stt.idGPU
+ * @return		사용할 수 없으면 false
+ */
+static bool __check_engine(const bool useGPU, const long idGPU) {
+	if (!useGPU)
+		return true;
+#ifdef DNN_CPU_ONLY
+	job_log->crit("stt.useGPU is true, but the CPU DNN engine (libdnn.cpu) is linked. "
+				  "Set stt.useGPU = false or run itf_vr");
+	return false;
+#else
+	int devices = 0;
+	if (cudaGetDeviceCount(&devices) != 0 || idGPU < 0 || idGPU >= devices) {
+		job_log->crit("stt.useGPU is true, but GPU %ld is not available (%d devices). "
+					  "Set stt.useGPU = false or run itf_vr_cpu", idGPU, devices);
+		return false;
+	}
+	return true;
+#endif
+}
+
 /**
  * @brief		Load Laser module
  * @author		Youngsoo Min (ysmin@itfact.co.kr)
@@ -67,7 +147,10 @@ bool VRServer::load_laser_module() {
 
 	unsigned long engine_core = static_cast<unsigned long>(DEFAULT_ENGINE_CORE);
 	engine_core = config->getConfig<unsigned long>("stt.engine_core", engine_core);
-	job_log->info("load LASER(%s) module with %d cores", (useGPU ? "GPU" : "CPU"), engine_core);
+	job_log->info("load LASER(%s) module with %d cores, DNN engine: %s", (useGPU ? "GPU" : "CPU"), engine_core,
+				  (GPU_ENGINE ? "libdnn.gpu" : "libdnn.cpu"));
+	if (!__check_engine(useGPU, idGPU))
+		return false;
 	setLaserErrorHandleProc(NULL, (void *) errorHandler);
 	setSLaserLBCores(engine_core);
 	usleep(5 * 1024 * 1024);
@@ -77,6 +160,36 @@ bool VRServer::load_laser_module() {
 	if (image_path.at(image_path.size() - 1) != '/')
 		image_path.push_back('/');
 
+	// 특징 벡터 버퍼 (huge page)
+	FeatureArena::setHugePages(config->getConfig<bool>("stt.hugepages", false));
+
+	// 디코더 컨텍스트 풀 
+	max_idle_contexts = config->getConfig<unsigned long>("stt.context_pool", max_idle_contexts);
+	context_realloc = config->getConfig<unsigned long>("stt.context_realloc", context_realloc);
+	job_log->info("Decoder context pool: %lu, realloc after %lu frames", max_idle_contexts, context_realloc);
+
+	// 구간 병렬 인식 (msec 단위 설정을 8kHz 샘플 수로 변환)
+	chunk_length = config->getConfig<unsigned long>("stt.chunk_length", 0UL) * 8;
+	chunk_window = config->getConfig<unsigned long>("stt.chunk_window", 10UL * 1000) * 8;
+	chunk_threads = std::max(1UL, config->getConfig<unsigned long>("stt.chunk_threads", 4UL));
+	if (chunk_length)
+		job_log->info("Chunked decoding: %lu samples per chunk, %lu threads", chunk_length, chunk_threads);
+
+	// 비음성 구간 제거 (msec 단위 설정을 프레임 수로 변환)
+	vad.enable = config->getConfig<bool>("stt.vad", false);
+	vad.min_silence = config->getConfig<unsigned long>("stt.vad_min_silence", vad.min_silence * 10) / 10;
+	vad.hangover = config->getConfig<unsigned long>("stt.vad_hangover", vad.hangover * 10) / 10;
+	vad.ratio = config->getConfig("stt.vad_ratio", vad.ratio);
+	if (vad.enable)
+		job_log->info("VAD: drop non-speech longer than %lu frames (hangover %lu, ratio %.1f)",
+					  vad.min_silence, vad.hangover, vad.ratio);
+
+	// 쉼에 맞춘 디코더 초기화 (쉼 길이는 msec 단위 설정을 프레임 수로 변환)
+	reset_soft_period = config->getConfig<unsigned long>("stt.reset_soft_period", reset_soft_period);
+	reset_pause = std::max(1UL, config->getConfig<unsigned long>("stt.reset_pause", reset_pause * 10) / 10);
+	if (reset_soft_period)
+		job_log->info("Decoder reset: at a pause of %lu frames after %lu frames", reset_pause, reset_soft_period);
+
 	std::string chunking_file = std::string(image_path).
 			append(config->getConfig("stt.chunking_filename", default_config.chunking_filename.c_str()));
 	std::string tagging_file = std::string(image_path).
@@ -130,6 +243,40 @@ bool VRServer::load_laser_module() {
 	for (int i = 1; i <= 10; ++i)
 		memcpy(sil + i * (mfcc_size * 100), sil, sizeof(float) * mfcc_size * 100);
 
+	// 추가 도메인은 master 의 음향 모델과 DNN 을 함께 쓰는 child 를 하나씩 미리 만들어 그래프를 확인한다 
+	for (auto &domain : domains) {
+		if (domain.first.empty())
+			continue;
+		std::unique_ptr<DecoderContext> context(create_context(domain.first));
+		if (!context) {
+			job_log->crit("Fail to load domain %s: %s", domain.first.c_str(), domain.second.fsm_file.c_str());
+			goto fail;
+		}
+		context->reusable = true;
+		std::lock_guard<std::mutex> guard(context_lock);
+		idle_contexts[domain.first].push_back(std::move(context));
+		job_log->info("Domain %s: %s", domain.first.c_str(), domain.second.fsm_file.c_str());
+	}
+
+	// 스트림 간 음향 모델 배치 (CPU 전용)
+	if (!useGPU && config->getConfig<unsigned long>("stt.dnn_batch", 0UL) > 0) {
+		BatcherOptions batch;
+		batch.max_streams = config->getConfig<unsigned long>("stt.dnn_batch", 0UL);
+		batch.wait = std::chrono::microseconds(config->getConfig<unsigned long>("stt.dnn_batch_wait", 5UL) * 1000);
+		batch.mini_batch = mini_batch;
+		batch.frame_dim = mfcc_size;
+		batch.idGPU = idGPU;
+		batch.prior_weight = prior_weight;
+		batch.dnn_file = dnn_file;
+		batch.norm_file = norm_file;
+		batch.prior_file = prior_file;
+		if (AcousticBatcher::start(batch))
+			job_log->info("DNN batch: up to %lu streams, wait %lu us", batch.max_streams,
+						  static_cast<unsigned long>(batch.wait.count()));
+		else
+			job_log->error("Fail to start DNN batch, each stream computes its own minibatch");
+	}
+
 	// unsegment 초기화 
 	if (getTotalWorkers("unsegment") > 0) {
 		if (!Lat2cnWordNbestOutInit(
@@ -146,9 +293,15 @@ bool VRServer::load_laser_module() {
 	return true;
 
 fail:
+	{
+		std::lock_guard<std::mutex> guard(context_lock);
+		idle_contexts.clear();
+	}
 	if (sil)
 		free(sil);
+	sil = NULL;
 	freeMasterLaserDNN(masterLaserP);
+	masterLaserP = NULL;
 	return false;
 }
 
@@ -160,6 +313,12 @@ fail:
  * @see			load_laser_module()
  */
 void VRServer::unload_laser_module() {
+	// Child Laser 를 먼저 해제 
+	{
+		std::lock_guard<std::mutex> guard(context_lock);
+		idle_contexts.clear();
+	}
+	AcousticBatcher::stop();
 	if (masterLaserP)
 		freeMasterLaserDNN(masterLaserP);
 	if (sil)
@@ -169,6 +328,225 @@ void VRServer::unload_laser_module() {
 	masterLaserP = NULL;
 }
 
+/**
+ * @brief		디코더 컨텍스트 생성 
+ * @details		LFrontEnd 와 child Laser 를 만들고 특징 벡터 버퍼를 64 바이트 경계에 할당한다.
+ 				child Laser 는 domain 의 그래프로 탐색한다.
+ * @date		2026. 10. 17. 11:41:20
+ * @param[in]	domain	탐색 그래프 (stt.domains 의 이름, 기본 그래프는 빈 문자열)
+ * @return		생성된 컨텍스트. 실패 시 NULL
+ * @see			acquire_context()
+ */
+DecoderContext *VRServer::create_context(const std::string &domain) {
+	int rc;
+	auto graph = domains.find(domain);
+	if (graph == domains.end()) {
+		job_log->error("[0x%X] Unknown domain: %s" LOG_FMT, THREAD_ID, domain.c_str(), LOG_INFO);
+		return NULL;
+	}
+	std::unique_ptr<DecoderContext> context(new DecoderContext());
+	context->domain = domain;
+
+	LFrontEnd *_pFront = createLFrontEndExt(FRONTEND_OPTION_8KHZFRONTEND | FRONTEND_OPTION_DNNFBFRONTEND);
+	if (_pFront == NULL) {
+		job_log->error("[0x%X] Fail to createLFrontEndExt" LOG_FMT, THREAD_ID, LOG_INFO);
+		return NULL;
+	}
+	context->front.reset(_pFront, closeLFrontEnd);
+
+	if ((rc = readOptionLFrontEnd(context->front.get(), const_cast<char *>(frontend_config.c_str()))) != 0) {
+		job_log->error("[0x%X] Fail to readOptionFrontEnd: %s" LOG_FMT, THREAD_ID, frontend_config.c_str(), LOG_INFO);
+		return NULL;
+	}
+
+	if ((rc = setOptionLFrontEnd(context->front.get(), (char *)"FRONTEND_OPTION_DOEPD", (char *)"0")) != 0) {
+		job_log->error("[0x%X] Fail to setOptionLFrontEnd" LOG_FMT, THREAD_ID, LOG_INFO);
+		return NULL;
+	}
+
+	if ((rc = setOptionLFrontEnd(context->front.get(), (char *)"CMS_LEN_BLOCK", (char *)"0")) != 0) {
+		job_log->error("[0x%X] Fail to setOptionLFrontEnd" LOG_FMT, THREAD_ID, LOG_INFO);
+		return NULL;
+	}
+
+	Laser *_lP =
+		createChildLaserDNN(masterLaserP,
+							const_cast<char *>(am_file.c_str()),
+							const_cast<char *>(dnn_file.c_str()),
+							prior_weight,
+							const_cast<char *>(prior_file.c_str()),
+							const_cast<char *>(norm_file.c_str()),
+							mini_batch, (useGPU ? 1L : 0), idGPU,
+							const_cast<char *>(graph->second.fsm_file.c_str()),
+							const_cast<char *>(graph->second.sym_file.c_str()));
+	if (_lP == NULL) {
+		job_log->error("[0x%X] fail to createChildLaserDNN" LOG_FMT, THREAD_ID, LOG_INFO);
+		return NULL;
+	}
+	context->laser.reset(_lP, freeChildLaserDNN);
+
+	// 특징 벡터, 임시 버퍼
+	std::size_t frame_size = mfcc_size * mini_batch;
+	try {
+		context->feature_vector = FeatureBuffer(FeatureArena::make_shared(frame_size + mfcc_size * LDA_LEN_FRAMESTACK));
+		context->temp_buffer = FeatureArena::make_shared(frame_size);
+	} catch (std::bad_alloc &e) {
+		job_log->error("%s [at %s]", e.what(), "feature vector");
+		return NULL;
+	}
+
+	Metrics::add(COUNTER_CONTEXTS);
+	return context.release();
+}
+
+/**
+ * @brief		디코더 컨텍스트 할당 
+ * @details		쉬고 있는 컨텍스트가 있으면 초기화만 하여 재사용한다. 준비에 걸린 시간은 STAGE_SETUP 으로 기록한다.
+ 				반환된 포인터가 해제되면 컨텍스트는 풀로 돌아간다.
+ * @date		2026. 10. 17. 11:47:03
+ * @param[in]	domain	탐색 그래프 
+ * @return		컨텍스트. 실패 시 NULL
+ */
+std::shared_ptr<DecoderContext> VRServer::acquire_context(const std::string &domain) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::unique_ptr<DecoderContext> context;
+	{
+		std::lock_guard<std::mutex> guard(context_lock);
+		auto pool = idle_contexts.find(domain);
+		if (pool != idle_contexts.end() && !pool->second.empty()) {
+			context = std::move(pool->second.back());
+			pool->second.pop_back();
+		}
+	}
+
+	if (!context)
+		context.reset(create_context(domain));
+	if (!context)
+		return nullptr;
+
+	context->reusable = false;
+	resetSLaser(context->laser.get());
+	resetLFrontEnd(context->front.get());
+	Metrics::observe(STAGE_SETUP, start);
+
+	return std::shared_ptr<DecoderContext>(context.release(),
+										   [this](DecoderContext *used) {release_context(used);});
+}
+
+/**
+ * @brief		디코더 컨텍스트 반납 
+ * @details		오류로 끝난 컨텍스트는 버리며, stt.context_realloc 프레임 이상 탐색한 Laser 는
+ 				reallocSLaser 로 늘어난 메모리를 정리한 뒤 풀에 넣는다.
+ * @date		2026. 10. 17. 11:52:38
+ */
+void VRServer::release_context(DecoderContext *context) {
+	std::unique_ptr<DecoderContext> owner(context);
+	if (!context->reusable)
+		return;
+
+	if (context->frames >= context_realloc) {
+		if (reallocSLaser(context->laser.get()))
+			return;
+		context->frames = 0;
+	}
+
+	std::lock_guard<std::mutex> guard(context_lock);
+	std::vector<std::unique_ptr<DecoderContext>> &pool = idle_contexts[context->domain];
+	if (masterLaserP && pool.size() < max_idle_contexts)
+		pool.push_back(std::move(owner));
+}
+
+/**
+ * @brief		인식 결과를 이진 블록으로 변환 
+ * @details		텍스트 형식과 같이 tokenize_result() 로 나눈 줄에서 레코드와 문자열 테이블을 만든다.
+ 				끝 위치는 두 항목 이상 읽은 줄에서, 레코드는 네 항목을 모두 읽은 줄에서만 가져온다.
+ * @date		2026. 10. 17. 11:02:44
+ * @param[in]	result			getWBAdjustedResultSLaser 결과 
+ * @param[in]	last_position	시작/끝 프레임에 더할 위치 
+ * @param[out]	buffer			블록을 덧붙일 버퍼 
+ * @return		마지막 끝 프레임 (last_position 미포함)
+ */
+static int encode_binary_result(const char *result, const std::size_t last_position, std::string &buffer) {
+	static thread_local std::vector<BinaryResultRecord> records;
+	static thread_local std::string table;
+	records.clear();
+	table.clear();
+
+	int last_end = 0;
+	tokenize_result(result, result_words);
+	for (auto &word : result_words) {
+		if (word.fields >= 2)
+			last_end = static_cast<int>(word.end);
+		if (word.fields < 4)
+			continue;
+
+		BinaryResultRecord record = {
+			static_cast<uint32_t>(word.start + last_position),
+			static_cast<uint32_t>(last_end + last_position),
+			word.like,
+			static_cast<uint32_t>(table.size())
+		};
+		records.push_back(record);
+		table.append(word.word, word.length);
+		table.push_back('\0');
+	}
+	table.resize((table.size() + 3) & ~static_cast<std::size_t>(3), '\0');
+
+	BinaryResultBlock block = {static_cast<uint32_t>(records.size()), static_cast<uint32_t>(table.size())};
+	buffer.reserve(buffer.size() + sizeof(block) + records.size() * sizeof(BinaryResultRecord) + table.size());
+	buffer.append(reinterpret_cast<const char *>(&block), sizeof(block));
+	if (!records.empty())
+		buffer.append(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(BinaryResultRecord));
+	buffer.append(table);
+	return last_end;
+}
+
+/**
+ * @brief		비음성 구간을 제거하고 얻은 결과의 시간을 원본 기준으로 변환 
+ * @date		2026. 10. 17. 15:21:37
+ * @param[in]	speech			남긴 구간 
+ * @param[in]	start_position	원본 시작 프레임 
+ * @param[in]	format			결과 형식 
+ * @param[both]	buffer			결과 
+ * @param[in]	from			변환할 결과의 시작 위치 (get_final_result 호출 전 buffer 크기)
+ */
+static void remap_result(const SpeechMap &speech, const std::size_t start_position, const enum RESULT_FORMAT format,
+						 std::string &buffer, const std::size_t from) {
+	if (format == RESULT_BINARY) {
+		BinaryResultBlock block;
+		if (buffer.size() < from + sizeof(block))
+			return;
+		std::memcpy(&block, &buffer[from], sizeof(block));
+		char *records = &buffer[from + sizeof(block)];
+		for (uint32_t i = 0; i < block.count; ++i) {
+			BinaryResultRecord record;
+			std::memcpy(&record, records + i * sizeof(record), sizeof(record));
+			record.start = static_cast<uint32_t>(start_position + speech.toOriginal(record.start, false));
+			record.end = static_cast<uint32_t>(start_position + speech.toOriginal(record.end, true));
+			std::memcpy(records + i * sizeof(record), &record, sizeof(record));
+		}
+		return;
+	}
+
+	// "시작\t끝\t..." 줄의 앞 두 항목만 바꿈 
+	std::string remapped;
+	remapped.reserve(buffer.size() - from + 64);
+	std::size_t line = from;
+	while (line < buffer.size()) {
+		std::size_t next = buffer.find('\n', line);
+		next = (next == std::string::npos) ? buffer.size() : next + 1;
+		char *cursor;
+		unsigned long start = std::strtoul(&buffer[line], &cursor, 10);
+		unsigned long end = std::strtoul(cursor, &cursor, 10);
+		remapped.append(std::to_string(start_position + speech.toOriginal(start, false)));
+		remapped.push_back('\t');
+		remapped.append(std::to_string(start_position + speech.toOriginal(end, true)));
+		remapped.append(cursor, &buffer[0] + next - cursor);
+		line = next;
+	}
+	buffer.replace(from, std::string::npos, remapped);
+}
+
 /**
  * @brief		특징 벡터로부터 최종 인식 결과를 가져옴
  * @author		Youngsoo Min (ysmin@itfact.co.kr)
@@ -181,6 +559,7 @@ void VRServer::unload_laser_module() {
  * @param[in]	mfcc_size		
  * @param[in]	sil				
  * @param[out]	buffer			결과 저장
+ * @param[in]	format			결과 형식 
  * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
  				Otherwise,
  				a negative error code is returned indicating what went wrong.
@@ -193,12 +572,10 @@ int itfact::vr::node::get_final_result(
 	const std::size_t feature_dim,
 	const std::size_t mfcc_size,
 	float * const sil,
-	std::string &buffer
+	std::string &buffer,
+	const enum RESULT_FORMAT format
 ) {
-	int start = 0;
 	int end = 0;
-	char keyword[8192];
-	float like = 0.0; // likelihood
 
 	for (int i = 0; i < 40; ++i) {
 		if (stepSARecFrameExt(laser, index + i, feature_dim, sil + i * mfcc_size) != EXIT_SUCCESS) {
@@ -210,28 +587,23 @@ int itfact::vr::node::get_final_result(
 
 	// 단어 경계를 고려한 인식열에 대한 정렬이 완료된 최종 인식 결과를 가져옴
 	char *resultP = getWBAdjustedResultSLaser(laser, index + 40, 1, true);
-	if (resultP != NULL) {
-		std::string tmp_resultP(resultP);
-		tmp_resultP.push_back('\0');
-		std::vector<std::string> v_result;
-		boost::split(v_result, tmp_resultP, boost::is_any_of("\n"));
-		for (size_t i = 0; i < v_result.size(); ++i) {
-			memset(keyword, 0x00, 8192);
-			if (sscanf(v_result[i].c_str(), "%d %d %s %f", &start, &end, keyword, &like) < 4)
+	if (resultP != NULL && format == RESULT_BINARY) {
+		last_position += encode_binary_result(resultP, last_position, buffer);
+		return EXIT_SUCCESS;
+	} else if (resultP != NULL) {
+		tokenize_result(resultP, result_words);
+		for (auto &word : result_words) {
+			// 우도를 읽지 못한 줄도 끝 위치까지 읽었으면 last_position 에 반영
+			if (word.fields >= 2)
+				end = static_cast<int>(word.end);
+			if (word.fields < 4)
 				continue;
-			char *tmp_keyword = keyword;
 
-			// if (tmp_keyword[0] == '#')
-			// 	++tmp_keyword;
+			// if (word.word[0] == '#')
+			// 	++word.word;
 
-			buffer.append(boost::lexical_cast<std::string>(start + last_position));
-			buffer.push_back('\t');
-			buffer.append(boost::lexical_cast<std::string>(end + last_position));
-			buffer.push_back('\t');
-			buffer.append(tmp_keyword, std::strlen(tmp_keyword));
-			buffer.push_back('\t');
-			buffer.append(boost::lexical_cast<std::string>(like));
-			buffer.push_back('\n');
+			append_result_line(buffer, static_cast<int>(word.start) + last_position, end + last_position,
+							   word.word, word.length, word.like);
 		}
 
 		last_position += end;
@@ -264,36 +636,29 @@ int itfact::vr::node::get_intermediate_results(
 	std::size_t reset_period,
 	std::string &buffer
 ) {
-	std::size_t start = 0;
-	std::size_t end = 0;
-	char keyword[8192];
-	float like = 0.0; // likelihood
-
 	char *result = getWBAdjustedResultSLaser(laser, index, 1, true);
 	// char *result = getResultSLaser(laser, index, 1, true);
 	if (result) {
-		std::string str_result(result);
-		str_result.push_back('\0');
-
-		std::vector<std::string> v_result;
-		boost::split(v_result, str_result, boost::is_any_of("\n"));
-		for (size_t i = 0; i < v_result.size(); ++i) {
-			memset(keyword, 0x00, 8192);
-			if (sscanf(v_result[i].c_str(), "%lu %lu %s %f", &start, &end, keyword, &like) < 4)
+		tokenize_result(result, result_words);
+		for (auto &word : result_words) {
+			if (word.fields < 4)
 				continue;
+			std::size_t start = static_cast<std::size_t>(word.start);
+			std::size_t end = static_cast<std::size_t>(word.end);
 
 			// add code for co-work with rvrs by boolpae
 			if (!start) buffer.clear();
 
-			char *tmp_keyword = keyword;
+			const char *tmp_keyword = word.word;
+			std::size_t keyword_len = word.length;
 
 // add code for co-work with rvrs by boolpae
 #if 0
 			if (tmp_keyword[0] == '#')
-				++tmp_keyword;
+				++tmp_keyword, --keyword_len;
 #endif
-			//if (std::strlen(tmp_keyword) == 0)
-			if (std::strlen(tmp_keyword) == 0 || tmp_keyword[0] == '<')
+			//if (keyword_len == 0)
+			if (keyword_len == 0 || tmp_keyword[0] == '<')
 				continue;
 
 // add code for co-work with rvrs by boolpae
@@ -304,14 +669,7 @@ int itfact::vr::node::get_intermediate_results(
 			// if (tmp_keyword[0] != '<')
 			skip_position = end;
 #endif
-			buffer.append(boost::lexical_cast<std::string>(start + last_position));
-			buffer.push_back('\t');
-			buffer.append(boost::lexical_cast<std::string>(end + last_position));
-			buffer.push_back('\t');
-			buffer.append(tmp_keyword, std::strlen(tmp_keyword));
-			buffer.push_back('\t');
-			buffer.append(boost::lexical_cast<std::string>(like));
-			buffer.push_back('\n');
+			append_result_line(buffer, start + last_position, end + last_position, tmp_keyword, keyword_len, word.like);
 
 			// add code for co-work with rvrs by boolpae
 			if (end > reset_period) break;
@@ -325,217 +683,684 @@ int itfact::vr::node::get_intermediate_results(
 }
 
 /**
- * @brief		Speech to text
+ * @brief	특징 추출 단계 
+ * @details	next() 를 부를 때마다 녹취를 read_size 씩 읽어 특징 벡터 한 묶음을 만든다.
+ 			첫 묶음은 LDA 프레임 스택만큼 첫 프레임을 앞에 채우고, 마지막 묶음은 LFrontEnd 내부 버퍼를 비운다.
+ */
+class FeatureExtractor : private boost::noncopyable
+{
+public: // const
+	enum STAGE {
+		FEATURE_FIRST,	///< 첫 묶음 
+		FEATURE_NEXT,	///< 중간 묶음 
+		FEATURE_LAST	///< LFrontEnd 내부 버퍼 
+	};
+
+private: // Member
+	LFrontEnd *front;
+	const short *buffer;
+	const std::size_t buffer_len;
+	const std::size_t read_size;
+	const std::size_t mfcc_size;
+	const std::size_t mini_batch;
+	const std::size_t frame_stack;
+	float *temp_buffer;
+	float *sil;
+	PauseDetector *pause;
+	std::size_t offset = 0;
+	int fsize = 0;
+	enum STAGE stage = FEATURE_FIRST;
+
+public:
+	FeatureExtractor(LFrontEnd *a_front, const short *a_buffer, const std::size_t a_buffer_len,
+					 const std::size_t a_read_size, const std::size_t a_mfcc_size, const std::size_t a_mini_batch,
+					 const std::size_t a_frame_stack, float *a_temp_buffer, float *a_sil,
+					 PauseDetector *a_pause = NULL)
+		: front(a_front), buffer(a_buffer), buffer_len(a_buffer_len), read_size(a_read_size),
+		  mfcc_size(a_mfcc_size), mini_batch(a_mini_batch), frame_stack(a_frame_stack),
+		  temp_buffer(a_temp_buffer), sil(a_sil), pause(a_pause) {};
+
+	/**
+	 * @param[out]	output		특징 벡터 (mfcc_size * (mini_batch + frame_stack))
+	 * @param[out]	nf			프레임 수 
+	 * @param[out]	paused		지금까지 넣은 음성이 쉼으로 끝남 (pause 가 있을 때만)
+	 * @return		묶음 종류. FEATURE_LAST 이후에는 부르지 않는다.
+	 */
+	enum STAGE next(FeatureBuffer &output, std::size_t &nf, bool &paused, StageTimes &times) {
+		float *features = output.get();
+		int rc;
+		unsigned long i;
+
+		paused = false;
+
+		if (stage == FEATURE_FIRST) {
+			for (; offset < buffer_len; offset += read_size) {
+				int first_size = 0;
+				std::size_t rsize = read_size;
+				std::size_t remain = buffer_len - offset;
+				if (rsize > remain)
+					rsize = remain;
+
+				times.start();
+				rc = stepFrameLFrontEnd(front, rsize, const_cast<short *>(&buffer[offset]), &first_size, temp_buffer);
+				if (pause)
+					pause->feed(&buffer[offset], rsize);
+				times.stop(STAGE_FRONTEND);
+				job_log->debug("[0x%X] stepFrameLFrontEnd(0x%x), read: %d, fsize: %d" LOG_FMT,
+								THREAD_ID, rc, rsize, first_size, LOG_INFO);
+				if (first_size <= 0)
+					continue;
+
+				for (i = 0; i < frame_stack; ++i)
+					memcpy(features + i * mfcc_size, temp_buffer, sizeof(float) * mfcc_size);
+				memcpy(features + i * mfcc_size, temp_buffer, sizeof(float) * first_size);
+				first_size = first_size + i * mfcc_size;
+
+				// if (rc == noise)
+				// 	continue;
+				// else if (rc & timeout)
+				// 	continue; // FIXME: Retry??
+
+				nf = first_size / mfcc_size;
+				output.pad(nf, sil, mfcc_size, mini_batch);
+
+				offset += read_size;
+				stage = FEATURE_NEXT;
+				job_log->debug("[0x%X] offset: %d" LOG_FMT, THREAD_ID, offset, LOG_INFO);
+				return FEATURE_FIRST;
+			}
+
+			offset += read_size;
+			stage = FEATURE_NEXT;
+		}
+
+		for (; offset < buffer_len; ) {
+			std::size_t rsize = read_size;
+			std::size_t remain = buffer_len - offset;
+			if (rsize > remain)
+				rsize = remain;
+
+			// 음성 신호로부터 특징 벡터 출력
+			times.start();
+			rc = stepFrameLFrontEnd(front, rsize, const_cast<short *>(&buffer[offset]), &fsize, features);
+			if (pause)
+				pause->feed(&buffer[offset], rsize);
+			times.stop(STAGE_FRONTEND);
+			offset += read_size;
+			if (rc) job_log->debug("[0x%X] stepFrameLFrontEnd(0x%x), read: %d, fsize: %d" LOG_FMT,
+									THREAD_ID, rc, rsize, fsize, LOG_INFO);
+			if (fsize <= 0)
+				continue;
+
+			// if (rc == noise)
+			// 	continue;
+			// else if (rc & timeout)
+			// 	continue; // FIXME: Retry??
+
+			// noise // 노이즈 구간
+			// detecting // 음성 프레임 구간
+			// detected // 음성 종료 구간
+			// reset // LFrontEnd가 리셋됨. 검출된 음성 구간이 짧음
+			// onset // 음성 신호 시작
+			// offset // 음성 신호 종료
+			// timeout
+			// restart
+
+			// if (rc & detecting || rc & detected) {
+			// 	// 음성 프레임 구간
+			// } else if (rc & onset || rc & offset) {
+			// 	// 음성 신호 구간
+			// } else if (rc & reset) {
+			// 	job_log->debug("[0x%X] LFrontEnd was reset" LOG_FMT, THREAD_ID, LOG_INFO);
+			// 	// if (resetSLaser(lP.get())) {
+			// 	// 	job_log->error("[0x%X] Fail to resetSLaser" LOG_FMT, THREAD_ID, LOG_INFO);
+			// 	// 	return EXIT_FAILURE;
+			// 	// }
+
+			// 	if (read_size > remain) {
+			// 		// 녹취 파일의 끝이므로 분석 시도
+			// 	} else {
+			// 		// 검출된 음성이 짧으므로 모아서 처리
+			// 	}
+			// }
+
+			nf = fsize / mfcc_size;
+			output.pad(nf, sil, mfcc_size, mini_batch);
+			paused = pause && pause->paused();
+			return FEATURE_NEXT;
+		}
+
+		// flush internal buffer (static + zero padding -> dynamic feat)
+		times.start();
+		rc = stepFrameLFrontEnd(front, 0, NULL, &fsize, features);
+		times.stop(STAGE_FRONTEND);
+		job_log->debug("[0x%X] stepFrameLFrontEnd(0x%x), fsize: %d" LOG_FMT, THREAD_ID, rc, fsize, LOG_INFO);
+		nf = fsize / mfcc_size;
+		stage = FEATURE_LAST;
+		return FEATURE_LAST;
+	};
+};
+
+/**
+ * @brief	특징 추출 단계에서 탐색 단계로 넘기는 묶음 
+ */
+struct FeatureBatch {
+	FeatureBuffer *buffer;
+	std::size_t nf;
+	enum FeatureExtractor::STAGE stage;
+	bool paused;	///< 묶음 끝이 쉼 
+};
+
+/**
+ * @brief		비음성 구간 제거 
+ * @details		vad.enable 일 때만 제거하며, 결과 시간은 speech 로 원본 기준으로 되돌린다.
+ 				제거한 구간이 없으면 speech 를 비우고 buffer 를 그대로 가리킨다.
+ * @date		2026. 10. 17. 21:58:31
+ * @param[out]	speech	남긴 구간 
+ * @param[out]	kept	남긴 음성 (제거한 경우에만 채움)
+ * @param[out]	pcm		인식할 음성 
+ * @param[out]	pcm_len	인식할 음성 길이 
+ * @return		인식할 음성이 남지 않으면 false
+ */
+static bool drop_non_speech(const VadOptions &vad, const short *buffer, const std::size_t bufferLen,
+							SpeechMap &speech, std::vector<short> &kept, const short *&pcm, std::size_t &pcm_len) {
+	pcm = buffer;
+	pcm_len = bufferLen;
+	if (!vad.enable)
+		return true;
+
+	auto stage_start = std::chrono::steady_clock::now();
+	std::size_t dropped = VoiceActivityDetector(vad).detect(buffer, bufferLen, speech);
+	if (dropped) {
+		Metrics::add(COUNTER_SKIPPED, dropped);
+		VoiceActivityDetector::compact(buffer, speech, kept);
+		pcm = kept.data();
+		pcm_len = kept.size();
+	} else {
+		speech.clear();
+	}
+	Metrics::observe(STAGE_VAD, stage_start);
+	return pcm_len > 0;
+}
+
+/**
+ * @brief		Speech to text (한 구간)
+ * @details		stt.pipeline 이 true 이면 특징 추출을 별도 쓰레드에서 수행하고,
+ 				stt.pipeline_depth 개의 특징 벡터 버퍼를 링으로 돌려 쓰며 탐색과 겹쳐 실행한다.
+ 				두 단계가 처리하는 순서와 데이터는 같으므로 결과도 같다.\n
+ 				탐색한 프레임이 stt.reset_soft_period 를 넘으면 stt.reset_pause 이상의 쉼에서 결과를 확정하고
+ 				탐색을 초기화하며, stt.reset_period 는 쉼이 없어도 초기화하는 상한으로 남는다.
  * @author		Youngsoo Min (ysmin@itfact.co.kr)
  * @author		Kijeong Khil (kjkhil@itfact.co.kr)
  * @date		2016. 04. 19. 17:32
  * @param[in]	buffer		녹취 데이터 
  * @param[in]	bufferLen	녹취 데이터 길이 
  * @param[out]	result		STT 결과
+ * @param[in]	on_segment	지정되면 get_final_result 마다 result 에 쌓인 결과를 넘기고 비운다
+ * @param[in]	format		결과 형식 
+ * @param[in]	start_position	결과의 시작/끝 프레임에 더할 위치 (녹취 안에서 buffer 의 시작 프레임)
+ * @param[in]	domain		탐색 그래프 (stt.domains). 빈 문자열이면 stt.fsm_filename
  * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
  				Otherwise,
  				a negative error code is returned indicating what went wrong.
- * @see			VRServer::unsegment()
+ * @see			VRServer::stt()
  */
-int VRServer::stt(const short *buffer, const std::size_t bufferLen, std::string &result) {
+int VRServer::stt_segment(const short *buffer, const std::size_t bufferLen, std::string &result,
+						  const SegmentHandler &on_segment, const enum RESULT_FORMAT format,
+						  const std::size_t start_position, const std::string &domain) {
 	std::size_t read_size = 80 * mini_batch;
 	std::size_t reset_period = getConfig()->getConfig("stt.reset_period", default_config.reset_period);
-	unsigned long i;
 	int rc;
 
-	LFrontEnd *_pFront = createLFrontEndExt(FRONTEND_OPTION_8KHZFRONTEND | FRONTEND_OPTION_DNNFBFRONTEND);
-	if (_pFront == NULL) {
-		job_log->error("[0x%X] Fail to createLFrontEndExt" LOG_FMT, THREAD_ID, LOG_INFO);
-		return EXIT_FAILURE;
-	}
-	std::shared_ptr<LFrontEnd> pFront(_pFront, closeLFrontEnd);
-	
-	if ((rc = readOptionLFrontEnd(pFront.get(), const_cast<char *>(frontend_config.c_str()))) != 0) {
-		job_log->error("[0x%X] Fail to readOptionFrontEnd: %s" LOG_FMT, THREAD_ID, frontend_config.c_str(), LOG_INFO);
-		return EXIT_FAILURE;
-	}
+	// 비음성 구간 제거. 결과 시간은 speech 로 원본 기준으로 되돌린다 
+	SpeechMap speech;
+	std::vector<short> kept;
+	const short *pcm;
+	std::size_t pcm_len;
+	if (!drop_non_speech(vad, buffer, bufferLen, speech, kept, pcm, pcm_len))
+		return EXIT_SUCCESS;
+	bool use_pipeline = getConfig()->getConfig<bool>("stt.pipeline", false) && pcm_len > read_size * 2;
 
-	if ((rc = setOptionLFrontEnd(pFront.get(), (char *)"FRONTEND_OPTION_DOEPD", (char *)"0")) != 0) {
-		job_log->error("[0x%X] Fail to setOptionLFrontEnd" LOG_FMT, THREAD_ID, LOG_INFO);
+	std::shared_ptr<DecoderContext> context = acquire_context(domain);
+	if (!context)
 		return EXIT_FAILURE;
-	}
+	std::shared_ptr<Laser> &lP = context->laser;
+	PauseDetector pause(vad, reset_pause);
+	FeatureExtractor extractor(context->front.get(), pcm, pcm_len, read_size, mfcc_size, mini_batch,
+							   LDA_LEN_FRAMESTACK, context->temp_buffer.get(), sil,
+							   reset_soft_period ? &pause : NULL);
 
-	if ((rc = setOptionLFrontEnd(pFront.get(), (char *)"CMS_LEN_BLOCK", (char *)"0")) != 0) {
-		job_log->error("[0x%X] Fail to setOptionLFrontEnd" LOG_FMT, THREAD_ID, LOG_INFO);
-		return EXIT_FAILURE;
-	}
+	// 녹취 파일을 읽어가며 처리
+	StageTimes times;
+	std::size_t index = 0;
+	std::size_t last_position = speech.empty() ? start_position : 0;
+	auto final_result = [&]() -> int {
+		std::size_t from = result.size();
+		times.start();
+		int rc = get_final_result(lP.get(), index, last_position, feature_dim, mfcc_size, sil, result, format);
+		times.stop(STAGE_RESULT);
+		if (rc == EXIT_SUCCESS && !speech.empty())
+			remap_result(speech, start_position, format, result, from);
+		return rc;
+	};
+	auto search = [&](const FeatureBatch &batch) -> int {
+		unsigned long i;
+		times.start();
+		for (i = 0; i < batch.nf; ++i) {
+			// 특징 벡터의 차원 값을 추가적으로 사용하여 프레임 기반의 탐색을 수행 (feature_dim = 128 * 600)
+			if (stepSARecFrameExt(lP.get(), index + i, feature_dim, batch.buffer->get() + i * mfcc_size) != EXIT_SUCCESS)
+				return EXIT_FAILURE;
+		}
+		times.stop(STAGE_SEARCH);
+		times.addFrames(batch.nf);
+		index += batch.nf;
+
+		if (batch.stage == FeatureExtractor::FEATURE_NEXT &&
+			(index > reset_period || (reset_soft_period && index > reset_soft_period && batch.paused))) {
+			rc = final_result();
+			if (rc != EXIT_SUCCESS)
+				return EXIT_SUCCESS;
+			if (on_segment) {
+				if (!on_segment(result))
+					return EXIT_FAILURE;
+				result.clear();
+			}
 
-	Laser *_lP =
-		createChildLaserDNN(masterLaserP,
-							const_cast<char *>(am_file.c_str()),
-							const_cast<char *>(dnn_file.c_str()),
-							prior_weight,
-							const_cast<char *>(prior_file.c_str()),
-							const_cast<char *>(norm_file.c_str()),
-							mini_batch, (useGPU ? 1L : 0), idGPU,
-							const_cast<char *>(fsm_file.c_str()),
-							const_cast<char *>(sym_file.c_str()));
-	if (_lP == NULL) {
-		job_log->error("[0x%X] fail to createChildLaserDNN" LOG_FMT, THREAD_ID, LOG_INFO);
-		return EXIT_FAILURE;
-	}
-	std::shared_ptr<Laser> lP(_lP, freeChildLaserDNN);
+			// reallocSLaser(lP.get());
+			if (resetSLaser(lP.get())) {
+				job_log->error("[0x%X] Fail to resetSLaser" LOG_FMT, THREAD_ID, LOG_INFO);
+				return EXIT_FAILURE;
+			}
 
-	// 특징 벡터
-	std::size_t frame_size = mfcc_size * mini_batch;
-	float *_feature_vector = (float *) malloc(sizeof(float) * (frame_size + mfcc_size * LDA_LEN_FRAMESTACK)); 
-	if (_feature_vector == NULL) {
-		job_log->error("%s [at %s]", std::strerror(errno), "feature vector");
-		return EXIT_FAILURE;
-	}
-	std::shared_ptr<float> feature_vector(_feature_vector, free);
+			index = 0;
+		} else if (batch.stage == FeatureExtractor::FEATURE_LAST && index > 0) {
+			job_log->debug("[0x%X] partial backtracking size: %d" LOG_FMT, THREAD_ID, index * mfcc_size, LOG_INFO);
+			rc = final_result();
+			if (rc != EXIT_SUCCESS)
+				return EXIT_FAILURE;
+			if (on_segment) {
+				if (!on_segment(result))
+					return EXIT_FAILURE;
+				result.clear();
+			}
+		}
+		return EXIT_SUCCESS;
+	};
 
-	// 임시 버퍼
-	float *_temp_buffer = (float *) malloc(sizeof(float) * frame_size);
-	if (_temp_buffer == NULL) {
-		job_log->error("%s [at %s]", std::strerror(errno), "feature vector");
-		return EXIT_FAILURE;
+	if (!use_pipeline) {
+		FeatureBatch batch = {&context->feature_vector, 0, FeatureExtractor::FEATURE_FIRST, false};
+		do {
+			batch.stage = extractor.next(*batch.buffer, batch.nf, batch.paused, times);
+			if (search(batch) != EXIT_SUCCESS)
+				return EXIT_FAILURE;
+		} while (batch.stage != FeatureExtractor::FEATURE_LAST);
+	} else {
+		// 특징 벡터 버퍼는 컨텍스트와 함께 재사용 
+		std::size_t depth = getConfig()->getConfig<unsigned long>("stt.pipeline_depth", 4UL);
+		if (depth < 2)
+			depth = 2;
+		std::size_t buffer_size = mfcc_size * (mini_batch + LDA_LEN_FRAMESTACK);
+		try {
+			while (context->pipeline_buffers.size() < depth)
+				context->pipeline_buffers.emplace_back(FeatureArena::make_shared(buffer_size));
+		} catch (std::bad_alloc &e) {
+			job_log->error("%s [at %s]", e.what(), "pipeline buffer");
+			return EXIT_FAILURE;
+		}
+
+		SpscRing<FeatureBatch> free_batches(depth), ready_batches(depth);
+		for (std::size_t i = 0; i < depth; ++i)
+			free_batches.push({&context->pipeline_buffers[i], 0, FeatureExtractor::FEATURE_FIRST, false});
+
+		std::atomic<bool> abort(false);
+		std::thread frontend([&] {
+			StageTimes frontend_times;
+			FeatureBatch batch;
+			do {
+				if (!wait_until([&] {return free_batches.pop(batch);}, abort))
+					return;
+				batch.stage = extractor.next(*batch.buffer, batch.nf, batch.paused, frontend_times);
+				if (!wait_until([&] {return ready_batches.push(batch);}, abort))
+					return;
+			} while (batch.stage != FeatureExtractor::FEATURE_LAST);
+		});
+
+		FeatureBatch batch;
+		rc = EXIT_SUCCESS;
+		do {
+			wait_until([&] {return ready_batches.pop(batch);}, abort);
+			rc = search(batch);
+			free_batches.push(batch);
+		} while (rc == EXIT_SUCCESS && batch.stage != FeatureExtractor::FEATURE_LAST);
+
+		abort = true;
+		frontend.join();
+		if (rc != EXIT_SUCCESS)
+			return EXIT_FAILURE;
 	}
-	std::shared_ptr<float> temp_buffer(_temp_buffer, free);
 
-	resetSLaser(lP.get()); 
-	resetLFrontEnd(pFront.get());	
+	// 메모리 해제
+	//free(_feature_vector);
+	//free(_temp_buffer);
 
-	// 녹취 파일을 읽어가며 처리
-	std::size_t offset = 0;
-	std::size_t index = 0;
-	for (; offset < bufferLen; offset += read_size) {
-		int fsize = 0;
-		std::size_t rsize = read_size;
-		std::size_t remain = bufferLen - offset;
-		if (rsize > remain)
-			rsize = remain;
-
-		rc = stepFrameLFrontEnd(pFront.get(), rsize, const_cast<short *>(&buffer[offset]), &fsize, temp_buffer.get());
-		job_log->debug("[0x%X] stepFrameLFrontEnd(0x%x), read: %d, fsize: %d" LOG_FMT,
-						THREAD_ID, rc, rsize, fsize, LOG_INFO);
-		if (fsize <= 0)
-			continue;
+	// 정상 종료한 경우에만 다음 작업에 재사용 
+	context->frames += times.getFrames();
+	context->reusable = true;
+	return EXIT_SUCCESS;
+}
 
-		for (i = 0; i < LDA_LEN_FRAMESTACK; ++i)
-			memcpy(feature_vector.get() + i * mfcc_size, temp_buffer.get(), sizeof(float) * mfcc_size);
-		memcpy(feature_vector.get() + i * mfcc_size, temp_buffer.get(), sizeof(float) * fsize);
-		fsize = fsize + i * mfcc_size;
+/**
+ * @brief		여러 그래프로 한 번에 인식 
+ * @details		특징 추출과 음향 모델 계산은 한 번만 하고, 같은 특징 벡터로 그래프마다 child Laser 를 탐색한다.
+ 				미니배치마다 첫 그래프가 먼저 탐색하며 계산한 사후 확률을 SharedScores 로 나머지 그래프에 넘긴다.
+ 				결과 확정과 탐색 초기화는 모든 그래프가 같은 프레임에서 한다. 구간 병렬 인식과 stt.pipeline 은 쓰지 않는다.
+ * @date		2026. 10. 17. 22:06:47
+ * @param[in]	buffer		녹취 데이터 
+ * @param[in]	bufferLen	녹취 데이터 길이 
+ * @param[in]	graphs		탐색 그래프 (stt.domains 의 이름, 기본 그래프는 빈 문자열)
+ * @param[out]	results		graphs 순서의 STT 결과 
+ * @param[in]	format		결과 형식 
+ * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
+ 				Otherwise,
+ 				a negative error code is returned indicating what went wrong.
+ * @see			VRServer::stt_segment()
+ */
+int VRServer::stt_multi(const short *buffer, const std::size_t bufferLen, const std::vector<std::string> &graphs,
+						std::vector<std::string> &results, const enum RESULT_FORMAT format) {
+	std::size_t read_size = 80 * mini_batch;
+	std::size_t reset_period = getConfig()->getConfig("stt.reset_period", default_config.reset_period);
+	results.assign(graphs.size(), std::string());
+	if (graphs.empty())
+		return EXIT_FAILURE;
 
-		// if (rc == noise)
-		// 	continue;
-		// else if (rc & timeout)
-		// 	continue; // FIXME: Retry??
+	SpeechMap speech;
+	std::vector<short> kept;
+	const short *pcm;
+	std::size_t pcm_len;
+	if (!drop_non_speech(vad, buffer, bufferLen, speech, kept, pcm, pcm_len))
+		return EXIT_SUCCESS;
 
-		std::size_t nf = fsize / mfcc_size;
-		if (nf < mini_batch)
-			memcpy(feature_vector.get() + nf * mfcc_size, sil, sizeof(float) * mfcc_size * (mini_batch - nf));
+	std::vector<std::shared_ptr<DecoderContext>> contexts;
+	for (auto &graph : graphs) {
+		contexts.push_back(acquire_context(graph));
+		if (!contexts.back())
+			return EXIT_FAILURE;
+	}
+	DecoderContext &leader = *contexts.front();
+	PauseDetector pause(vad, reset_pause);
+	FeatureExtractor extractor(leader.front.get(), pcm, pcm_len, read_size, mfcc_size, mini_batch,
+							   LDA_LEN_FRAMESTACK, leader.temp_buffer.get(), sil,
+							   reset_soft_period ? &pause : NULL);
+	SharedScores scores(mini_batch + LDA_LEN_FRAMESTACK + 40);
+
+	StageTimes times;
+	std::size_t index = 0;
+	std::vector<std::size_t> last_positions(graphs.size(), 0);
+	std::vector<std::size_t> result_sizes(graphs.size(), 0), saved_positions(graphs.size(), 0);
+	// 한 그래프라도 실패하면 모든 그래프의 결과와 위치를 되돌려 같은 프레임에서 다시 확정하도록 함
+	auto final_results = [&]() -> int {
+		for (std::size_t g = 0; g < contexts.size(); ++g) {
+			result_sizes[g] = results[g].size();
+			saved_positions[g] = last_positions[g];
+		}
+		for (std::size_t g = 0; g < contexts.size(); ++g) {
+			if (g == 0)
+				scores.lead();
+			else
+				scores.follow();
+			times.start();
+			int rc = get_final_result(contexts[g]->laser.get(), index, last_positions[g], feature_dim, mfcc_size,
+									  sil, results[g], format);
+			times.stop(STAGE_RESULT);
+			if (rc != EXIT_SUCCESS) {
+				for (std::size_t k = 0; k < contexts.size(); ++k) {
+					results[k].resize(result_sizes[k]);
+					last_positions[k] = saved_positions[k];
+				}
+				return rc;
+			}
+			if (!speech.empty())
+				remap_result(speech, 0, format, results[g], result_sizes[g]);
+		}
+		return EXIT_SUCCESS;
+	};
+
+	FeatureBatch batch = {&leader.feature_vector, 0, FeatureExtractor::FEATURE_FIRST, false};
+	do {
+		batch.stage = extractor.next(*batch.buffer, batch.nf, batch.paused, times);
+
+		times.start();
+		for (std::size_t g = 0; g < contexts.size(); ++g) {
+			if (g == 0)
+				scores.lead();
+			else
+				scores.follow();
+			for (std::size_t i = 0; i < batch.nf; ++i) {
+				if (stepSARecFrameExt(contexts[g]->laser.get(), index + i, feature_dim,
+									  batch.buffer->get() + i * mfcc_size) != EXIT_SUCCESS)
+					return EXIT_FAILURE;
+			}
+		}
+		times.stop(STAGE_SEARCH);
+		times.addFrames(batch.nf);
+		index += batch.nf;
 
-		for (i = 0; i < nf; ++i) {
-			// 특징 벡터의 차원 값을 추가적으로 사용하여 프레임 기반의 탐색을 수행 (feature_dim = 128 * 600)
-			if (stepSARecFrameExt(lP.get(), index + i, feature_dim, feature_vector.get() + i * mfcc_size) != EXIT_SUCCESS)
+		if (batch.stage == FeatureExtractor::FEATURE_NEXT &&
+			(index > reset_period || (reset_soft_period && index > reset_soft_period && batch.paused))) {
+			if (final_results() != EXIT_SUCCESS)
+				continue;
+			for (auto &context : contexts) {
+				if (resetSLaser(context->laser.get())) {
+					job_log->error("[0x%X] Fail to resetSLaser" LOG_FMT, THREAD_ID, LOG_INFO);
+					return EXIT_FAILURE;
+				}
+			}
+			index = 0;
+		} else if (batch.stage == FeatureExtractor::FEATURE_LAST && index > 0) {
+			if (final_results() != EXIT_SUCCESS)
 				return EXIT_FAILURE;
 		}
+	} while (batch.stage != FeatureExtractor::FEATURE_LAST);
 
-		index += nf;
-		break;
+	job_log->debug("[0x%X] %lu graphs, %lu shared scores" LOG_FMT, THREAD_ID, graphs.size(), scores.getHits(), LOG_INFO);
+	for (auto &context : contexts) {
+		context->frames += times.getFrames();
+		context->reusable = true;
 	}
+	return EXIT_SUCCESS;
+}
 
-	offset += read_size;
-	job_log->debug("[0x%X] index: %d, offset: %d" LOG_FMT, THREAD_ID, index, offset, LOG_INFO);
-	std::size_t last_position = 0;
-	int fsize = 0;
-	for (; offset < bufferLen; offset += read_size) {
-		std::size_t rsize = read_size;
-		std::size_t remain = bufferLen - offset;
-		if (rsize > remain)
-			rsize = remain;
-
-		// 음성 신호로부터 특징 벡터 출력
-		rc = stepFrameLFrontEnd(pFront.get(), rsize, const_cast<short *>(&buffer[offset]), &fsize,feature_vector.get());
-		if (rc) job_log->debug("[0x%X] stepFrameLFrontEnd(0x%x), read: %d, fsize: %d" LOG_FMT,
-								THREAD_ID, rc, rsize, fsize, LOG_INFO);
-		if (fsize <= 0)
-			continue;
+/**
+ * @brief		Speech to text
+ * @details		stt.chunk_length 가 설정되고 녹취가 그 1.5배보다 길면 묵음 지점에서 나누어 병렬로 인식한다.
+ * @author		Kijeong Khil (kjkhil@itfact.co.kr)
+ * @date		2016. 04. 19. 17:32
+ * @param[in]	buffer		녹취 데이터 
+ * @param[in]	bufferLen	녹취 데이터 길이 
+ * @param[out]	result		STT 결과
+ * @param[in]	on_segment	지정되면 확정된 결과를 순서대로 넘긴다
+ * @param[in]	format		결과 형식 
+ * @param[in]	domain		탐색 그래프 
+ * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
+ 				Otherwise,
+ 				a negative error code is returned indicating what went wrong.
+ * @see			VRServer::stt_segment(), VRServer::stt_chunked()
+ */
+int VRServer::stt(const short *buffer, const std::size_t bufferLen, std::string &result,
+				  const SegmentHandler &on_segment, const enum RESULT_FORMAT format, const std::string &domain) {
+	if (chunk_length && bufferLen > chunk_length + chunk_length / 2)
+		return stt_chunked(buffer, bufferLen, result, on_segment, format, domain);
+	return stt_segment(buffer, bufferLen, result, on_segment, format, 0, domain);
+}
 
-		// if (rc == noise)
-		// 	continue;
-		// else if (rc & timeout)
-		// 	continue; // FIXME: Retry??
-
-		// noise // 노이즈 구간
-		// detecting // 음성 프레임 구간
-		// detected // 음성 종료 구간
-		// reset // LFrontEnd가 리셋됨. 검출된 음성 구간이 짧음
-		// onset // 음성 신호 시작
-		// offset // 음성 신호 종료
-		// timeout
-		// restart
-
-		// if (rc & detecting || rc & detected) {
-		// 	// 음성 프레임 구간
-		// } else if (rc & onset || rc & offset) {
-		// 	// 음성 신호 구간
-		// } else if (rc & reset) {
-		// 	job_log->debug("[0x%X] LFrontEnd was reset" LOG_FMT, THREAD_ID, LOG_INFO);
-		// 	// if (resetSLaser(lP.get())) {
-		// 	// 	job_log->error("[0x%X] Fail to resetSLaser" LOG_FMT, THREAD_ID, LOG_INFO);
-		// 	// 	return EXIT_FAILURE;
-		// 	// }
-
-		// 	if (read_size > remain) {
-		// 		// 녹취 파일의 끝이므로 분석 시도
-		// 	} else {
-		// 		// 검출된 음성이 짧으므로 모아서 처리
-		// 	}
-		// }
-
-		std::size_t nf = fsize / mfcc_size;
-		if (nf < mini_batch)
-			memcpy(feature_vector.get() + nf * mfcc_size, sil, sizeof(float) * mfcc_size * (mini_batch - nf));
-
-		for (i = 0; i < nf; ++i) {
-			// 특징 벡터의 차원 값을 추가적으로 사용하여 프레임 기반의 탐색을 수행 (feature_dim = 128 * 600)
-			if (stepSARecFrameExt(lP.get(), index + i, feature_dim, feature_vector.get() + i * mfcc_size) != EXIT_SUCCESS)
-				return EXIT_FAILURE;
-		}
-		index += nf;
+/**
+ * @brief		묵음 지점 탐색 
+ * @details		length 마다 앞뒤 window 범위에서 200ms 구간 에너지 합이 가장 작은 곳의 가운데를 경계로 정한다.
+ 				경계는 프레임(80 샘플) 단위로 맞추며, 마지막 구간이 length 의 절반보다 짧으면 앞 구간에 붙인다.
+ * @date		2026. 10. 17. 14:02:26
+ * @param[in]	buffer		녹취 데이터 
+ * @param[in]	bufferLen	녹취 데이터 길이 (샘플)
+ * @param[in]	length		목표 구간 길이 (샘플)
+ * @param[in]	window		경계를 찾을 범위 (샘플)
+ * @return		0 과 bufferLen 을 포함한 구간 경계 
+ */
+std::vector<std::size_t> VRServer::split_at_silence(const short *buffer, const std::size_t bufferLen,
+												   const std::size_t length, const std::size_t window) {
+	const std::size_t frame = 80;
+	const std::size_t span = 20;	// 200ms
+	std::vector<std::size_t> bounds(1, 0);
+	if (length < frame * span * 2 || bufferLen < length + length / 2) {
+		bounds.push_back(bufferLen);
+		return bounds;
+	}
 
-		if (index > reset_period) {
-			if (get_final_result(lP.get(), index, last_position, feature_dim, mfcc_size, sil, result) != EXIT_SUCCESS)
-				continue;
+	// 프레임 에너지 
+	std::size_t frames = bufferLen / frame;
+	std::vector<uint64_t> energy(frames + 1, 0);
+	for (std::size_t i = 0; i < frames; ++i) {
+		uint64_t sum = 0;
+		const short *sample = buffer + i * frame;
+		for (std::size_t j = 0; j < frame; ++j)
+			sum += static_cast<int64_t>(sample[j]) * sample[j];
+		energy[i + 1] = energy[i] + sum;	// 누적합
+	}
 
-			// reallocSLaser(lP.get());
-			if (resetSLaser(lP.get())) {
-				job_log->error("[0x%X] Fail to resetSLaser" LOG_FMT, THREAD_ID, LOG_INFO);
-				return EXIT_FAILURE;
+	std::size_t chunk_frames = length / frame;
+	std::size_t window_frames = std::min(window / frame, chunk_frames / 2);
+	std::size_t last = 0;
+	while (frames - last >= chunk_frames + chunk_frames / 2) {
+		std::size_t target = last + chunk_frames;
+		std::size_t begin = target - window_frames;
+		std::size_t end = std::min(target + window_frames, frames - chunk_frames / 2);
+		std::size_t best = target;
+		uint64_t best_energy = UINT64_MAX;
+		for (std::size_t i = begin; i + span <= end; ++i) {
+			uint64_t sum = energy[i + span] - energy[i];
+			if (sum < best_energy) {
+				best_energy = sum;
+				best = i + span / 2;
 			}
-
-			index = 0;
 		}
+		bounds.push_back(best * frame);
+		last = best;
 	}
+	bounds.push_back(bufferLen);
+	return bounds;
+}
 
-	// flush internal buffer (static + zero padding -> dynamic feat)
-	rc = stepFrameLFrontEnd(pFront.get(), 0, NULL, &fsize, feature_vector.get());
-	job_log->debug("[0x%X] stepFrameLFrontEnd(0x%x), fsize: %d" LOG_FMT, THREAD_ID, rc, fsize, LOG_INFO);
-	std::size_t nf = fsize / mfcc_size;
-	for (i = 0; i < nf; ++i) {
-		if (stepSARecFrameExt(lP.get(), index + i, feature_dim, feature_vector.get() + i * mfcc_size) != EXIT_SUCCESS)
-			return EXIT_FAILURE;
-	}
-	index += nf;
+/**
+ * @brief		구간별 병렬 인식 
+ * @details		split_at_silence() 로 나눈 구간을 최대 stt.chunk_threads 개의 쓰레드가 각자의 디코더 컨텍스트로 인식한다.
+ 				구간의 결과는 시작 프레임을 start_position 으로 넘겨 get_final_result 와 같은 방식으로 시간을 맞추고,
+ 				구간 순서대로 이어 붙인다. on_segment 가 있으면 앞 구간이 모두 끝난 구간부터 차례로 넘긴다.
+ 				보조 처리는 연산 풀의 빈 슬롯(WorkerDaemon::submitHelper())에서 하며, 슬롯이 없으면 호출 쓰레드가 모두 인식한다.
+ 				결과 전달(on_segment)은 호출 쓰레드에서만 한다.
+ * @date		2026. 10. 17. 14:10:53
+ * @param[in]	buffer		녹취 데이터 
+ * @param[in]	bufferLen	녹취 데이터 길이 
+ * @param[out]	result		STT 결과
+ * @param[in]	on_segment	지정되면 구간 결과를 순서대로 넘긴다
+ * @param[in]	format		결과 형식 
+ * @param[in]	domain		탐색 그래프 
+ * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
+ 				Otherwise,
+ 				a negative error code is returned indicating what went wrong.
+ * @see			VRServer::stt_segment()
+ */
+int VRServer::stt_chunked(const short *buffer, const std::size_t bufferLen, std::string &result,
+						  const SegmentHandler &on_segment, const enum RESULT_FORMAT format,
+						  const std::string &domain) {
+	std::vector<std::size_t> bounds = split_at_silence(buffer, bufferLen, chunk_length, chunk_window);
+	const std::size_t chunks = bounds.size() - 1;
+	job_log->debug("[0x%X] split %lu samples into %lu chunks" LOG_FMT, THREAD_ID, bufferLen, chunks, LOG_INFO);
+
+	std::vector<std::string> results(chunks);
+	std::vector<int> codes(chunks, EXIT_SUCCESS);
+	std::vector<char> done(chunks, 0);
+	std::size_t emitted = 0;
+	bool failed = false;
+	std::mutex lock;
+	std::condition_variable finished;
+	std::atomic<std::size_t> next(0);
+
+	// 구간 하나를 인식하여 결과만 저장하고 호출 쓰레드를 깨움
+	auto decode_chunk = [&](const std::size_t i) {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (failed)
+				return false;
+		}
+		std::string chunk_result;
+		int rc = EXIT_FAILURE;
+		try {
+			rc = stt_segment(buffer + bounds[i], bounds[i + 1] - bounds[i], chunk_result, nullptr, format,
+							 bounds[i] / 80, domain);
+		} catch (std::exception &e) {
+			job_log->error("[0x%X] %s" LOG_FMT, THREAD_ID, e.what(), LOG_INFO);
+		}
 
-	if (index > 0) {
-		job_log->debug("[0x%X] partial backtracking size: %d" LOG_FMT, THREAD_ID, index * mfcc_size, LOG_INFO);
-		if (get_final_result(lP.get(), index, last_position, feature_dim, mfcc_size, sil, result) != EXIT_SUCCESS)
-			return EXIT_FAILURE;
+		std::lock_guard<std::mutex> guard(lock);
+		results[i].swap(chunk_result);
+		codes[i] = rc;
+		done[i] = 1;
+		if (rc != EXIT_SUCCESS)
+			failed = true;
+		finished.notify_one();
+		return true;
+	};
+
+	// 앞 구간부터 끝난 결과를 넘김 (호출 쓰레드)
+	auto emit = [&](std::unique_lock<std::mutex> &guard) {
+		while (!failed && emitted < chunks && done[emitted]) {
+			std::string segment;
+			segment.swap(results[emitted]);
+			if (codes[emitted++] != EXIT_SUCCESS) {
+				failed = true;
+				break;
+			}
+			if (!on_segment) {
+				result.append(segment);
+				continue;
+			}
+			if (segment.empty())
+				continue;
+			guard.unlock();
+			bool sent = on_segment(segment);
+			guard.lock();
+			if (!sent)
+				failed = true;
+		}
+	};
+
+	// 보조 처리는 연산 풀의 빈 슬롯에서만 실행하므로 master.compute_threads 를 넘지 않음
+	TaskGroup helpers(this);
+	std::size_t threads = std::min(chunk_threads, chunks);
+	for (std::size_t i = 1; i < threads; ++i) {
+		bool spawned = helpers.spawn([&]() {
+			for (std::size_t chunk = next++; chunk < chunks && decode_chunk(chunk); chunk = next++)
+				;
+		});
+		if (!spawned)
+			break;
 	}
 
-	// 메모리 해제
-	//free(_feature_vector);
-	//free(_temp_buffer);
+	// 호출 쓰레드도 남은 구간을 인식하며, 구간 사이마다 끝난 결과를 넘김
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		for (emit(guard); !failed && emitted < chunks; emit(guard)) {
+			std::size_t i = next++;
+			if (i < chunks) {
+				guard.unlock();
+				decode_chunk(i);
+				guard.lock();
+			} else {
+				finished.wait(guard);
+			}
+		}
+	}
+	helpers.wait();
 
-	return EXIT_SUCCESS;
+	return (failed || emitted != chunks) ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
 /**
@@ -553,27 +1378,23 @@ int VRServer::stt(const short *buffer, const std::size_t bufferLen, std::string
 int VRServer::unsegment(const std::string &cell_data, std::string &result) {
 	char tmp_buf1[9082];
 	char tmp_buf2[9082];
-	unsigned long start = 0;
-	unsigned long end = 0;
-	float like = 0.0; // likelihood
-	char keyword[8192];
 
-	std::vector<std::string> line;
 	std::string tmp_buf;
-	boost::split(line, cell_data, boost::is_any_of("\n"));
-	for (size_t i = 0; i < line.size(); ++i) {
-		memset(keyword, 0x00, 8192);
-		if (sscanf(line[i].c_str(), "%lu\t%lu\t%s\t%f", &start, &end, keyword, &like) < 3)
+	tokenize_result(cell_data.c_str(), result_words);
+	for (auto &word : result_words) {
+		if (word.fields < 3)
 			continue;
 
-		char *tmp_keyword = keyword;
-		if (strncmp(tmp_keyword, "<s>", 3) == 0 || strncmp(tmp_keyword, "</s>", 4) == 0)
+		const char *tmp_keyword = word.word;
+		std::size_t keyword_len = word.length;
+		if ((keyword_len >= 3 && strncmp(tmp_keyword, "<s>", 3) == 0) ||
+			(keyword_len >= 4 && strncmp(tmp_keyword, "</s>", 4) == 0))
 			continue;
 
 		if (tmp_keyword[0] == '#')
-			++tmp_keyword;
+			++tmp_keyword, --keyword_len;
 
-		tmp_buf.append(tmp_keyword);
+		tmp_buf.append(tmp_keyword, keyword_len);
 		tmp_buf.push_back(' ');
 
 		if (tmp_buf.size() > 125) {
@@ -758,7 +1579,7 @@ int VRServer::ssp(const std::string &mlf_file, std::string &buf) {
  * @author		Kijeong Khil (kjkhil@itfact.co.kr)
  * @date		2016. 07. 20. 10:49:33
  * @param[in]	data		WAVE data
- * @param[in]	data_size	WAVE data size
+ * @param[in]	data_size	WAVE data size (short 단위)
  * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
  				Otherwise,
  				a negative error code is returned indicating what went wrong.
@@ -773,20 +1594,15 @@ enum WAVE_FORMAT VRServer::check_wave_format(const short *data, const size_t dat
 		return UNKNOWN_FORMAT;
 
 	if (std::strncmp(cdata, "RIFF", 4) == 0) {
-		std::string metadata(cdata + 8 , 7);
-		short channels = *(short *) (cdata + 22);
-		int32_t sample_rate = *(int32_t *) (cdata + 24);
-		short bits = *(short *) (cdata + 34);
-
-		if (std::strncmp(cdata + 8, "WAVEfmt", 7) == 0) {
-			job_log->debug("Standard WAVE Fromat");
-			if (sample_rate == 8000 && bits == 16 && channels == 1)
+		WaveInfo wave;
+		if (parse_wave(cdata, data_size * sizeof(short), wave)) {
+			job_log->debug("Encoding: 0x%X, Sample rate: %d, Bits: %d, Channels: %d",
+						   wave.encoding, wave.sample_rate, wave.bits, wave.channels);
+			if (wave.encoding == ENCODING_PCM && wave.sample_rate == 8000 && wave.bits == 16 && wave.channels == 1)
 				return STANDARD_WAVE;
-			else if (channels == 2)
+			else if (wave.channels == 2)
 				return WAVE_2CH;
 		}
-
-		job_log->debug("Sample rate: %d, Bits: %d, Channels: %d", sample_rate, bits, channels);
 		return WAVE;
 	}
 
@@ -810,6 +1626,9 @@ enum WAVE_FORMAT VRServer::check_wave_format(const short *data, const size_t dat
 int VRServer::create_channel(const std::string &call_id) {
 	int rc;
 	std::size_t reset_period = getConfig()->getConfig("realtime.reset_period", default_config.reset_period);
+	std::size_t soft_period = getConfig()->getConfig<unsigned long>("realtime.reset_soft_period", reset_soft_period);
+	uint32_t sample_rate = getConfig()->getConfig<unsigned long>("realtime.sample_rate", PcmConverter::OUTPUT_RATE);
+	std::size_t channels = getConfig()->getConfig<std::size_t>("realtime.channels", 1);
 
 	job_log->debug("[0x%X] Create channel" LOG_FMT, THREAD_ID, LOG_INFO);
 
@@ -852,28 +1671,35 @@ int VRServer::create_channel(const std::string &call_id) {
 	}
 	std::shared_ptr<Laser> child_laser(_lP, freeChildLaserDNN);
 
-	// 특징 벡터
-	std::size_t frame_size = mfcc_size * mini_batch;
-	float *_feature_vector = (float *) malloc(sizeof(float) * (frame_size + mfcc_size * LDA_LEN_FRAMESTACK)); 
-	if (_feature_vector == NULL) {
-		job_log->error("%s [at %s]", std::strerror(errno), "feature vector");
-		return EXIT_FAILURE;
-	}
-	std::shared_ptr<float> feature_vector(_feature_vector, free);
-
 	resetSLaser(child_laser.get()); 
 	resetLFrontEnd(frontend.get());
 
-	std::shared_ptr<RealtimeSTT> realtime_stt =
-		std::make_shared<RealtimeSTT>(
+	// 특징 벡터
+	std::size_t frame_size = mfcc_size * mini_batch;
+	std::shared_ptr<RealtimeSTT> realtime_stt;
+	try {
+		std::shared_ptr<float> feature_vector =
+			FeatureArena::make_shared(frame_size + mfcc_size * LDA_LEN_FRAMESTACK);
+		realtime_stt = std::make_shared<RealtimeSTT>(
 			feature_vector, frontend, child_laser, mfcc_size, mini_batch, sil, job_log);
+	} catch (std::bad_alloc &e) {
+		job_log->error("%s [at %s]", e.what(), "feature vector");
+		return EXIT_FAILURE;
+	}
 #if 0
 	auto search = channel.find(call_id);
 	if (search != channel.end())
 		return EXIT_FAILURE;
 #endif
+	try {
+		realtime_stt->set_input_format(sample_rate, channels);
+	} catch (std::invalid_argument &e) {
+		job_log->error("[0x%X] Unsupported input: %uHz, %lu channels" LOG_FMT, THREAD_ID, sample_rate, channels, LOG_INFO);
+		return EXIT_FAILURE;
+	}
 	channel[call_id] = realtime_stt;
 	realtime_stt->set_reset_period(reset_period);
+	realtime_stt->set_soft_reset(soft_period, vad, reset_pause);
 
 	return EXIT_SUCCESS;
 }
@@ -930,7 +1756,10 @@ int VRServer::stt(
 	}
 
 	auto node = channel[call_id];
-	int rc = node->stt(buffer, bufferLen, result);
+	const short *data = buffer;
+	std::size_t length = bufferLen;
+	node->convert(data, length, state == 2);
+	int rc = length ? node->stt(data, length, result) : EXIT_SUCCESS;
 
 	if (state == 2) {
 		rc = node->free_buffer(result);
@@ -10,9 +10,15 @@
 #ifndef __ITFACT_VR_SERVER_H__
 #define __ITFACT_VR_SERVER_H__
 
+#include <cstdint>
+#include <functional>
+
 #include "worker.hpp"
 #include "frontend_api.h"
 #include "Laser.h"
+#include "vad.hpp"
+#include "audio.hpp"
+#include "arena.hpp"
 
 using namespace itfact::worker;
 
@@ -26,11 +32,65 @@ namespace itfact {
 				MPEG,
 				UNKNOWN_FORMAT
 			};
+			/**
+			 * @brief	STT 결과 형식
+			 */
+			enum RESULT_FORMAT {
+				RESULT_TEXT,	///< "시작\t끝\t단어\t우도\n" 반복
+				RESULT_BINARY	///< BinaryResultBlock 반복
+			};
+
+			/**
+			 * @brief	이진 결과 블록 헤더 (host byte order)
+			 * @details	헤더 뒤에 BinaryResultRecord 가 count 개, NUL 로 끝나는 단어를 모은
+			 			문자열 테이블이 table_size 바이트 이어진다. table_size 는 4의 배수로 채운다.
+			 */
+			struct BinaryResultBlock {
+				uint32_t count;
+				uint32_t table_size;
+			};
+
+			struct BinaryResultRecord {
+				uint32_t start;			///< 시작 프레임 
+				uint32_t end;			///< 끝 프레임 
+				float likelihood;
+				uint32_t word;			///< 문자열 테이블 내 위치 
+			};
+
+			/// vr_stt_bin 결과의 시작. 뒤에 음성 데이터 크기(uint32_t)와 블록이 이어진다
+			const char BINARY_RESULT_MAGIC[4] = {'V', 'R', 'B', '1'};
+
 			class RealtimeSTT;
 
+			/// 확정된 인식 결과 전달. false 를 반환하면 인식을 중단
+			typedef std::function<bool (std::string &segment)> SegmentHandler;
+
+			/**
+			 * @brief	작업 사이에 재사용하는 디코더 컨텍스트 
+			 */
+			struct DecoderContext {
+				std::shared_ptr<LFrontEnd> front;
+				std::shared_ptr<Laser> laser;
+				FeatureBuffer feature_vector;
+				std::shared_ptr<float> temp_buffer;
+				std::vector<FeatureBuffer> pipeline_buffers;	///< stt.pipeline 사용 시 
+				std::size_t frames = 0;		///< 마지막 reallocSLaser 이후 탐색한 프레임 
+				bool reusable = false;		///< 작업이 정상 종료됨 
+				std::string domain;			///< 탐색 그래프 (VRServer::domains)
+			};
+
+			/**
+			 * @brief	도메인별 언어 모델 그래프 
+			 * @details	음향 모델과 DNN 은 masterLaserP 하나를 함께 쓰고, child Laser 만 도메인의 그래프로 만든다.
+			 */
+			struct DecodingDomain {
+				std::string fsm_file;
+				std::string sym_file;
+			};
+
 			int get_final_result(Laser *slaserP, std::size_t index, std::size_t &last_position,
 				const std::size_t feature_dim, const std::size_t mfcc_size, float * const sil,
-				std::string &buffer);
+				std::string &buffer, const enum RESULT_FORMAT format = RESULT_TEXT);
 			int get_intermediate_results(Laser *laser, std::size_t index,
 				std::size_t &skip_position, std::size_t last_position, std::size_t reset_period, std::string &buffer);
 
@@ -40,6 +100,11 @@ namespace itfact {
 				static const unsigned long MAX_MINIBATCH = 1024;
 				static const unsigned long DEFAULT_ENGINE_CORE = 10;
 				static const unsigned long LDA_LEN_FRAMESTACK = 15;
+#ifdef DNN_CPU_ONLY
+				static const bool GPU_ENGINE = false;	///< libdnn.cpu 로 링크 (itf_vr_cpu)
+#else
+				static const bool GPU_ENGINE = true;	///< libdnn.gpu 로 링크 (itf_vr)
+#endif
 
 			private: // Member
 				std::shared_ptr<std::thread> monitoring_thread;
@@ -47,11 +112,28 @@ namespace itfact {
 				float *sil = NULL;
 				std::map<std::string, std::shared_ptr<RealtimeSTT>> channel;
 
+				// 디코더 컨텍스트 풀 (도메인별)
+				std::map<std::string, std::vector<std::unique_ptr<DecoderContext>>> idle_contexts;
+				std::mutex context_lock;
+				std::size_t max_idle_contexts = 1024;	///< 도메인마다 
+				std::size_t context_realloc = 360000;	///< 약 1시간 (10ms/frame)
+
+				// 구간 병렬 인식 (샘플 단위)
+				std::size_t chunk_length = 0;		///< 0 이면 사용하지 않음 
+				std::size_t chunk_window = 80000;
+				std::size_t chunk_threads = 4;
+
+				VadOptions vad;
+
+				// 쉼에 맞춘 디코더 초기화 (frame 단위)
+				std::size_t reset_soft_period = 30000;	///< 약 5분. 이후 쉼에서 초기화. 0 이면 사용하지 않음
+				std::size_t reset_pause = 30;			///< 쉼으로 볼 비음성 길이
+
 				// ----------
 				std::size_t mfcc_size = 600;
 				std::size_t mini_batch = 128;
 				double prior_weight = 0.8L;
-				bool useGPU = true;
+				bool useGPU = GPU_ENGINE;
 				long idGPU = 0;
 				std::size_t feature_dim;
 				std::size_t read_size;
@@ -63,13 +145,37 @@ namespace itfact {
 				std::string dnn_file;
 				std::string prior_file;
 				std::string norm_file;
+				std::map<std::string, DecodingDomain> domains;	///< "" 는 stt.fsm_filename, 나머지는 stt.domains
 
 			public:
 				VRServer() : WorkerDaemon() {};
 				VRServer(const int argc, const char *argv[]) : WorkerDaemon(argc, argv) {};
 				~VRServer();
 				virtual int initialize() override;
-				int stt(const short *buffer, const std::size_t bufferLen, std::string &result);
+				bool load();
+				int stt(const short *buffer, const std::size_t bufferLen, std::string &result,
+						const SegmentHandler &on_segment = nullptr, const enum RESULT_FORMAT format = RESULT_TEXT,
+						const std::string &domain = std::string());
+				int stt_segment(const short *buffer, const std::size_t bufferLen, std::string &result,
+								const SegmentHandler &on_segment, const enum RESULT_FORMAT format,
+								const std::size_t start_position, const std::string &domain = std::string());
+				int stt_chunked(const short *buffer, const std::size_t bufferLen, std::string &result,
+								const SegmentHandler &on_segment = nullptr,
+								const enum RESULT_FORMAT format = RESULT_TEXT,
+								const std::string &domain = std::string());
+				int stt_multi(const short *buffer, const std::size_t bufferLen, const std::vector<std::string> &graphs,
+							  std::vector<std::string> &results, const enum RESULT_FORMAT format = RESULT_TEXT);
+				bool hasDomain(const std::string &domain) const {return domains.count(domain) > 0;};
+				std::vector<std::string> getDomains() const {
+					std::vector<std::string> names;
+					for (auto &domain : domains)
+						names.push_back(domain.first);
+					return names;
+				};
+				std::size_t getChunkLength() const {return chunk_length;};
+				std::size_t getChunkWindow() const {return chunk_window;};
+				static std::vector<std::size_t> split_at_silence(const short *buffer, const std::size_t bufferLen,
+																 const std::size_t length, const std::size_t window);
 				int unsegment(const std::string &data, std::string &result);
 				int unsegment_with_time(const std::string &mlf_file, const std::string &unseg_file);
 				int ssp(const std::string &mlf_file, std::string &buf);
@@ -81,8 +187,12 @@ namespace itfact {
 
 			private:
 				int monitoring(std::shared_ptr<std::string> path);
+				void load_config();
 				bool load_laser_module();
 				void unload_laser_module();
+				DecoderContext *create_context(const std::string &domain);
+				std::shared_ptr<DecoderContext> acquire_context(const std::string &domain);
+				void release_context(DecoderContext *context);
 
 				// For Real-time
 				int create_channel(const std::string &call_id);
@@ -93,13 +203,15 @@ namespace itfact {
 			{
 			private:
 				log4cpp::Category *job_log = NULL;
-				std::shared_ptr<float> feature_vector;
+				FeatureBuffer feature_vector;
 				std::shared_ptr<LFrontEnd> front;
 				std::shared_ptr<Laser> laser;
-				float *temp_buffer = NULL;//short *temp_buffer = NULL;
+				std::shared_ptr<float> temp_buffer;//short *temp_buffer = NULL;
 				std::size_t temp_buffer_len = 0;
 				std::size_t running = 0;
 				std::size_t reset_period;
+				std::size_t reset_soft_period = 0;
+				std::unique_ptr<PauseDetector> pause;
 				std::size_t index = 0;
 				std::size_t skip_position = 0;
 				std::size_t last_position = 0;
@@ -111,6 +223,9 @@ namespace itfact {
 				std::size_t feature_dim;
 				float *sil = NULL;
 
+				std::unique_ptr<PcmConverter> converter;	///< 8kHz 단일 채널이 아닌 입력 변환
+				std::vector<short> converted;
+
 			public:
 				RealtimeSTT(std::shared_ptr<float> buffer,
 							std::shared_ptr<LFrontEnd> frontend,
@@ -122,6 +237,9 @@ namespace itfact {
 				~RealtimeSTT();
 
 				void set_reset_period(const std::size_t period);
+				void set_soft_reset(const std::size_t period, const VadOptions &vad, const std::size_t pause_frames);
+				void set_input_format(const uint32_t sample_rate, const std::size_t channels);
+				void convert(const short *&buffer, std::size_t &buffer_len, const bool is_last);
 				int stt(const short *buffer, const std::size_t buffer_len, std::string &result);
 				int free_buffer(std::string &result);
 
@@ -6,8 +6,11 @@
  * @date	2016. 06. 17. 17:32:24
  * @see		
  */
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
+#include <cstring>
+#include <chrono>
 #include <fstream>
 #include <time.h>
 #include <unistd.h>
@@ -19,6 +22,7 @@
 
 #include "ETRIPP.h"
 #include "vr.hpp"
+#include "audio.hpp"
 #include "restapi.hpp"
 
 #include <iostream>
@@ -30,6 +34,8 @@ static log4cpp::Category *job_log = NULL;
 static std::string tmp_path;
 
 static gearman_return_t job_stt(gearman_job_st *job, void *context);
+static gearman_return_t job_stt_batch(gearman_job_st *job, void *context);
+static gearman_return_t job_stt_multi(gearman_job_st *job, void *context);
 static gearman_return_t job_rt_stt(gearman_job_st *job, void *context);
 static gearman_return_t job_unsegment(gearman_job_st *job, void *context);
 static gearman_return_t job_unsegment_with_time(gearman_job_st *job, void *context);
@@ -56,6 +62,7 @@ static struct {
 	std::string fail_nofile;
 	std::string fail_download;
 	std::string fail_decoding;
+	std::string fail_domain;
 } default_config = {
 	.laser_config = "config/stt_laser.cfg",
 	.frontend_config = "config/frontend_dnn.cfg",
@@ -73,38 +80,21 @@ static struct {
 	.fail_nofile = "E10100",
 	.fail_download = "E10200",
 	.fail_decoding = "E20400",
+	.fail_domain = "E10300",
 };
 
-/**
- */
-int main(const int argc, char const *argv[]) {
-	try {
-		VRServer server(argc, argv);
-		server.initialize();
-	} catch (std::exception &e) {
-		perror(e.what());
-		return EXIT_FAILURE;
-	}
-
-	return EXIT_SUCCESS;
-}
-
 VRServer::~VRServer() {
 	if (masterLaserP)
 		unload_laser_module();
 }
 
 /**
- * @brief		초기화 후 실행 
+ * @brief		설정값 로드 
  * @author		Kijeong Khil (kjkhil@itfact.co.kr)
  * @date		2016. 06. 27. 10:12:37
- * @param[in]	argc	인수의 개수 
- * @param[in]	argc	인수 배열 
- * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
- 				Otherwise,
- 				a negative error code is returned indicating what went wrong.
+ * @see			VRServer::initialize(), VRServer::load()
  */
-int VRServer::initialize() {
+void VRServer::load_config() {
 	const itfact::common::Configuration *config = getConfig();
 	std::string image_path = "./";
 	image_path = config->getConfig("stt.image_path", image_path.c_str());
@@ -118,6 +108,10 @@ int VRServer::initialize() {
 	job_log->debug("=========================================");
 
 	job_log->debug("stt.worker: %d", getTotalWorkers("stt"));
+	job_log->debug("stt_stream.worker: %d", getTotalWorkers("stt_stream"));
+	job_log->debug("stt_bin.worker: %d", getTotalWorkers("stt_bin"));
+	job_log->debug("stt_batch.worker: %d, threads(%d)", getTotalWorkers("stt_batch"), config->getConfig("stt_batch.threads", 4));
+	job_log->debug("stt_multi.worker: %d", getTotalWorkers("stt_multi"));
 	job_log->debug("unsegment.worker: %d", getTotalWorkers("unsegment"));
 	job_log->debug("ssp.worker: %d", getTotalWorkers("ssp"));
 	job_log->debug("realtime.worker: %d, startnum(%d)", getTotalWorkers("realtime"), config->getConfig("realtime.startnum", 1));
@@ -158,6 +152,27 @@ int VRServer::initialize() {
 	norm_file = std::string(image_path).
 			append(config->getConfig("stt.norm_filename", default_config.norm_filename.c_str()));
 
+	// 도메인별 언어 모델 그래프 (stt.<도메인>.fsm_filename, 없으면 <도메인>.sfsm.bin)
+	domains.clear();
+	domains[""] = DecodingDomain{fsm_file, sym_file};
+	std::vector<std::string> domain_names;
+	std::string domain_list = config->getConfig("stt.domains", "");
+	boost::split(domain_names, domain_list, boost::is_any_of(", \t"), boost::token_compress_on);
+	for (auto &name : domain_names) {
+		if (name.empty())
+			continue;
+		if (name == "default") {
+			job_log->warn("stt.domains: \"default\" is the stt.fsm_filename graph");
+			continue;
+		}
+		DecodingDomain &domain = domains[name];
+		domain.fsm_file = std::string(image_path).
+				append(config->getConfig("stt." + name + ".fsm_filename", (name + ".sfsm.bin").c_str()));
+		domain.sym_file = std::string(image_path).
+				append(config->getConfig("stt." + name + ".sym_filename", (name + ".sym.bin").c_str()));
+		job_log->debug("stt.domains[%s]: %s, %s", name.c_str(), domain.fsm_file.c_str(), domain.sym_file.c_str());
+	}
+
 	std::string chunking_file = std::string(image_path).
 			append(config->getConfig("stt.chunking_filename", default_config.chunking_filename.c_str()));
 	std::string tagging_file = std::string(image_path).
@@ -180,19 +195,53 @@ int VRServer::initialize() {
 	job_log->debug("stt.tagging_filename: %s", tagging_file.c_str());
 	job_log->debug("stt.user_dic: %s", user_dic_file.c_str());
 	job_log->debug("=========================================");
+}
+
+/**
+ * @brief		Gearman 작업 없이 인식 엔진만 적재 
+ * @details		vr_bench 와 같이 VRServer::stt() 를 직접 호출하는 경우에 사용한다.
+ * @date		2026. 10. 17. 14:31:07
+ * @retval		true	Success
+ * @retval		false	Failure
+ */
+bool VRServer::load() {
+	load_config();
+	return load_laser_module();
+}
+
+/**
+ * @brief		초기화 후 실행 
+ * @author		Kijeong Khil (kjkhil@itfact.co.kr)
+ * @date		2016. 06. 27. 10:12:37
+ * @param[in]	argc	인수의 개수 
+ * @param[in]	argc	인수 배열 
+ * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
+ 				Otherwise,
+ 				a negative error code is returned indicating what went wrong.
+ */
+int VRServer::initialize() {
+	const itfact::common::Configuration *config = getConfig();
+	load_config();
 
 	//FIXME: License 체크 
 
+	// 이후 생성되는 모든 쓰레드는 종료 시그널을 받지 않음
+	catchSignals();
+
 	// module 초기화 
 	if (!load_laser_module())
 		return EXIT_FAILURE;
 
 	// Controller 실행 
-	RestApi api(config, job_log);
+	RestApi api(config, job_log, this);
 	api.start();
 
 	job_log->info("Connect to Master server(%s:%d)", config->getHost().c_str(), config->getPort());
 	run("vr_stt", this, getTotalWorkers("stt"), job_stt);
+	run("vr_stt_batch", this, getTotalWorkers("stt_batch"), job_stt_batch);
+	run("vr_stt_multi", this, getTotalWorkers("stt_multi"), job_stt_multi);
+	run("vr_stt_stream", this, getTotalWorkers("stt_stream"), job_stt);
+	run("vr_stt_bin", this, getTotalWorkers("stt_bin"), job_stt);
 	run("vr_text_only", this, getTotalWorkers("unsegment"), job_unsegment);
 	run("vr_text", this, getTotalWorkers("unsegment"), job_unsegment_with_time);
 	run("vr_ssp", this, getTotalWorkers("ssp"), job_ssp);
@@ -209,6 +258,16 @@ int VRServer::initialize() {
 	return EXIT_SUCCESS;
 }
 
+/**
+ * @brief		오류 코드 전송 
+ * @date		2026. 10. 16. 17:31:09
+ * @param[in]	code	오류 코드 
+ */
+static inline void __send_error(gearman_job_st *job, const std::string &code) {
+	Metrics::fail(code);
+	WorkerDaemon::sendWarning(job, code.c_str(), code.size());
+}
+
 /**
  * @brief		파일 저장 
  * @author		Kijeong Khil (kjkhil@itfact.co.kr)
@@ -286,10 +345,8 @@ __store_file(gearman_job_st *job, const char *job_name, const bool is_wave,
 		}
 		std::shared_ptr<std::FILE> fd(fp, std::fclose);
 
-		for (size_t i = 0; i < size; ++i) {
-			if (std::fwrite((char *)&data[i], sizeof(short), 1, fd.get()) == 0)
-				job_log->warn("[%s] Write size is zero: %s", job_name, std::strerror(errno));
-		}
+		if (std::fwrite(data, sizeof(short), size, fd.get()) != size)
+			job_log->warn("[%s] Write size is mismatch: %s", job_name, std::strerror(errno));
 	}
 
 	return true;
@@ -297,6 +354,7 @@ __store_file(gearman_job_st *job, const char *job_name, const bool is_wave,
 
 /**
  * @brief		파일 로드  
+ * @details		디코딩된 파일을 매핑하므로 로드 후 파일을 삭제해도 버퍼는 유지된다.
  * @author		Kijeong Khil (kjkhil@itfact.co.kr)
  * @date		2016. 10. 14. 17:57:51
  * @param[in]	job_name	Job name
@@ -304,15 +362,12 @@ __store_file(gearman_job_st *job, const char *job_name, const bool is_wave,
  				Otherwise, a FALSE is returned.
  * @see			job_stt()
  */
-static inline bool __load_file(const std::string &output_file, std::vector<short> &buffer) {
-	std::FILE *fp = std::fopen(output_file.c_str(), "rb");
-	if (!fp)
+static inline bool __load_file(const std::string &output_file, AudioBuffer &buffer) {
+	try {
+		buffer.map(output_file);
+	} catch (std::exception &e) {
 		return false;
-	std::shared_ptr<std::FILE> fd(fp, std::fclose);
-
-	short sData;
-	while (std::fread(&sData, sizeof(short), 1, fd.get()) > 0)
-		buffer.push_back(sData);
+	}
 
 	return true;
 }
@@ -326,9 +381,12 @@ static inline bool __load_file(const std::string &output_file, std::vector<short
  				Otherwise, a FALSE is returned.
  * @see			job_stt()
  */
-static inline bool __job_stt(VRServer *server, short *data, size_t size, std::string &cell_data) {
+static inline bool __job_stt(VRServer *server, const short *data, size_t size, std::string &cell_data,
+							 const SegmentHandler &on_segment = nullptr,
+							 const enum RESULT_FORMAT format = RESULT_TEXT,
+							 const std::string &domain = std::string()) {
 	try {
-		int rc = server->stt(data, size, cell_data);
+		int rc = server->stt(data, size, cell_data, on_segment, format, domain);
 		if (rc)
 			return false;
 
@@ -341,73 +399,238 @@ static inline bool __job_stt(VRServer *server, short *data, size_t size, std::st
 }
 
 /**
- * @brief		STT 요청 
- * @author		Kijeong Khil (kjkhil@itfact.co.kr)
- * @date		2016. 06. 27. 13:39:27
- * @return		Upon successful completion, a GEARMAN_SUCCESS is returned.\n
- 				Otherwise, a GEARMAN_ERROR is returned.
- * @see			job_unsegment()
+ * @brief		2채널 STT 수행
+ * @details		채널을 분리하여 오른쪽 채널은 연산 풀의 빈 슬롯에서 동시에 인식하며, 빈 슬롯이 없으면 왼쪽 채널 다음에 인식한다.
+ 				결과는 "왼쪽||오른쪽" 이며, on_segment 가 있으면 왼쪽 채널 결과를 먼저 모두 넘긴 뒤
+ 				"||" 와 오른쪽 채널 결과를 넘긴다.
+ * @date		2026. 10. 17. 15:56:12
+ * @param[in]	server	VR 인스턴스 
+ * @param[in]	data	2채널 16bit PCM
+ * @param[in]	size	전체 샘플 수 
+ * @return		Upon successful completion, a TRUE is returned.\n
+ 				Otherwise, a FALSE is returned.
+ * @see			job_stt()
  */
-static gearman_return_t job_stt(gearman_job_st *job, void *context) {
-	const char *workload = (const char *) gearman_job_workload(job);
-	const size_t workload_size = gearman_job_workload_size(job);
-	std::string __job_name(COLOR_BLACK_BOLD);
-	__job_name.append("STT:");
-	__job_name.append(gearman_job_handle(job));
-	__job_name.append(COLOR_NC);
-	const char *job_name = __job_name.c_str();
-	VRServer *server = (VRServer *) context;
+static bool __job_stt_stereo(VRServer *server, const short *data, size_t size, std::string &cell_data,
+							 const SegmentHandler &on_segment = nullptr,
+							 const std::string &domain = std::string()) {
+	const size_t frames = size / 2;
+	std::vector<short> left(frames), right(frames);
+	deinterleave_stereo(data, frames, left.data(), right.data());
+
+	std::string right_data("||");
+	bool right_ok = false;
+	auto decode_right = [&]() {
+		right_ok = __job_stt(server, right.data(), frames, right_data, nullptr, RESULT_TEXT, domain);
+	};
+	TaskGroup helpers(server);
+	bool concurrent = helpers.spawn(decode_right);
+	bool left_ok = __job_stt(server, left.data(), frames, cell_data, on_segment, RESULT_TEXT, domain);
+	helpers.wait();
+	if (!concurrent && left_ok)
+		decode_right();
+	if (!left_ok || !right_ok)
+		return false;
 
-	job_log->info("[%s] Recieved %d bytes", job_name, workload_size);
-	if (workload_size < 10) {
-		job_log->error("[%s] The file size is too small (< 10 bytes)", job_name);
-		gearman_job_send_fail(job);
-		return GEARMAN_ERROR;
+	if (on_segment)
+		return on_segment(right_data);
+	cell_data.append(right_data);
+	return true;
+}
+
+/**
+ * @brief		작업 도메인 해석 
+ * @details		workload 가 "domain=<이름>[,<이름>...]\\n" 으로 시작하면 그 줄을 떼어 내고 stt.domains 의 그래프를 선택한다.
+ 				"default" 는 기본 그래프(stt.fsm_filename)이며 빈 문자열로 돌려준다.
+ * @date		2026. 10. 17. 21:18:40
+ * @param[both]	workload		도메인 줄을 뺀 나머지를 가리킴 
+ * @param[both]	workload_size	나머지 크기 
+ * @param[out]	domains			도메인 이름. 지정하지 않았으면 비어 있음
+ * @return		등록되지 않은 도메인이 있으면 false
+ * @see			job_stt(), job_stt_batch(), job_stt_multi()
+ */
+static bool __take_domains(VRServer *server, const char *job_name,
+						   const char *&workload, size_t &workload_size, std::vector<std::string> &domains) {
+	static const char prefix[] = "domain=";
+	const size_t prefix_size = sizeof(prefix) - 1;
+	domains.clear();
+	if (workload_size < prefix_size || std::memcmp(workload, prefix, prefix_size) != 0)
+		return true;
+
+	const char *end = static_cast<const char *>(std::memchr(workload, '\n', workload_size));
+	if (end == NULL) {
+		job_log->error("[%s] Missing workload after domain", job_name);
+		return false;
 	}
+	std::string line(workload + prefix_size, end);
+	workload_size -= end + 1 - workload;
+	workload = end + 1;
+
+	boost::split(domains, line, boost::is_any_of(", \t\r"), boost::token_compress_on);
+	domains.erase(std::remove_if(domains.begin(), domains.end(),
+								 [](const std::string &domain) {return domain.empty();}), domains.end());
+	for (auto &domain : domains) {
+		if (domain == "default")
+			domain.clear();
+		else if (!server->hasDomain(domain)) {
+			job_log->error("[%s] Unknown domain: %s", job_name, domain.c_str());
+			return false;
+		}
+	}
+	job_log->debug("[%s] Domain: %s", job_name, line.c_str());
+	return true;
+}
 
-	// 프로토콜 확인 
-	short *data;
-	size_t size;
-	std::vector<short> buffer;
+/**
+ * @brief		작업 도메인 하나 해석 
+ * @return		등록되지 않은 도메인이거나 둘 이상이면 false
+ * @see			__take_domains()
+ */
+static bool __take_domain(VRServer *server, const char *job_name,
+						  const char *&workload, size_t &workload_size, std::string &domain) {
+	std::vector<std::string> domains;
+	if (!__take_domains(server, job_name, workload, workload_size, domains))
+		return false;
+	if (domains.size() > 1) {
+		job_log->error("[%s] Only one domain is allowed, use vr_stt_multi", job_name);
+		return false;
+	}
+	domain = domains.empty() ? std::string() : domains.front();
+	return true;
+}
+
+/**
+ * @brief		WAVE 를 프로세스 내에서 PCM 으로 변환 
+ * @details		decode_wave() 가 지원하는 부호화일 때만 변환한다. 2채널은 channels 가 지정되고
+ 				stt.split_channels 가 true 이면 채널 교차 배치 그대로 넘기고, 아니면 하나로 합친다.
+ 				8kHz 가 아니면 PcmConverter 로 8kHz 로 변환한다. 분리할 2채널은 8kHz 만 지원한다.
+ 				8kHz 16bit PCM 은 복사하지 않고 data 청크를 가리킨다.
+ * @date		2026. 10. 17. 16:31:15
+ * @param[both]	buffer		변환된 데이터로 교체 
+ * @param[both]	data		PCM 데이터 
+ * @param[both]	size		PCM 샘플 수 
+ * @param[out]	channels	채널 수 
+ * @return		변환하지 못하면 false (stt.decoder 사용)
+ * @see			__prepare_audio()
+ */
+static bool __decode_wave(VRServer *server, const char *job_name, AudioBuffer &buffer,
+						  const short *&data, size_t &size, size_t *channels) {
+	if (!server->getConfig()->getConfig<bool>("stt.native_decode", true))
+		return false;
+
+	WaveInfo wave;
+	bool split = false;
+	if (parse_wave((const char *) data, size * sizeof(short), wave) && wave.channels == 2)
+		split = channels && server->getConfig()->getConfig<bool>("stt.split_channels", false);
+	if (!can_decode_wave(wave) || wave.sample_rate == 0 || wave.channels > 2 ||
+		(split && wave.sample_rate != PcmConverter::OUTPUT_RATE)) {
+		job_log->debug("[%s] Not supported in process: 0x%X, %dHz, %dbit, %dch", job_name,
+					   wave.encoding, wave.sample_rate, wave.bits, wave.channels);
+		return false;
+	}
+
+	std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
+	const bool convert = !split && (wave.channels != 1 || wave.sample_rate != PcmConverter::OUTPUT_RATE);
+	const short *pcm_data;
+	size_t pcm_size;
+	std::vector<char> pcm;
+	if (wave.encoding == ENCODING_PCM && wave.bits == 16) {
+		pcm_data = (const short *) wave.data;
+		pcm_size = wave.data_size / wave.block_align * wave.channels;
+	} else {
+		pcm_size = decode_wave(wave, pcm);
+		pcm_data = (const short *) pcm.data();
+	}
+	Metrics::observe(STAGE_DECODE, stage_start);
+
+	if (convert) {
+		stage_start = std::chrono::steady_clock::now();
+		std::vector<short> converted;
+		converted.reserve(pcm_size / wave.channels * PcmConverter::OUTPUT_RATE / wave.sample_rate + 1);
+		PcmConverter converter(wave.sample_rate, wave.channels);
+		converter.process(pcm_data, pcm_size, converted);
+		converter.flush(converted);
+		buffer.clear();
+		buffer.append((const char *) converted.data(), converted.size() * sizeof(short));
+		data = buffer.data();
+		size = buffer.size();
+		Metrics::observe(STAGE_RESAMPLE, stage_start);
+	} else if (pcm.empty()) {
+		data = pcm_data;
+		size = pcm_size;
+	} else {
+		buffer.assign(std::move(pcm));
+		data = buffer.data();
+		size = pcm_size;
+	}
+	if (channels)
+		*channels = convert ? 1 : wave.channels;
+	job_log->info("[%s] Decoded in process: 0x%X, %dHz, %dbit, %dch", job_name,
+				  wave.encoding, wave.sample_rate, wave.bits, wave.channels);
+	return true;
+}
+
+/**
+ * @brief		음성 데이터 준비 
+ * @details		녹취를 다운로드하고 포멧을 확인하여, 필요하면 외부 디코더로 PCM 으로 변환한다.
+ 				workload 가 URI 가 아니면 workload 자체를 PCM 으로 사용한다.
+ * @date		2026. 10. 17. 10:05:42
+ * @param[in]	job_name	Job name
+ * @param[out]	buffer	다운로드 또는 디코딩된 데이터 
+ * @param[out]	data	PCM 데이터 (buffer 또는 workload 를 가리킴)
+ * @param[out]	size	PCM 샘플 수 
+ * @param[out]	error	클라이언트에 알릴 오류 코드. 없으면 빈 문자열
+ * @param[out]	channels	지정되면 2채널 WAVE 를 디코딩하지 않고 그대로 넘기고 채널 수를 기록
+ * @return		Upon successful completion, a TRUE is returned.\n
+ 				Otherwise, a FALSE is returned.
+ * @see			job_stt()
+ */
+static bool
+__prepare_audio(VRServer *server, const char *job_name, const char *workload, const size_t workload_size,
+				AudioBuffer &buffer, const short *&data, size_t &size, std::string &error,
+				size_t *channels = NULL) {
 	enum PROTOCOL protocol;
+	if (channels)
+		*channels = 1;
 
 	// 프로토콜로 오는 경우 파일패스에 쓰레기 값이 붙는 현상이 있어서 데이터 처리
-	std::string get_file_nm("");
-	get_file_nm = workload;
-	get_file_nm = get_file_nm.substr(0, workload_size);
+	std::string get_file_nm(workload, workload_size);
 	job_log->debug("[%s] workload ==> %s", job_name, get_file_nm.c_str());
 
+	std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
 	try {
 		//protocol = WorkerDaemon::downloadData(server->getConfig(), workload, workload_size, buffer);
 		protocol = WorkerDaemon::downloadData(server->getConfig(), get_file_nm.c_str() , workload_size, buffer);
+		Metrics::observe(STAGE_DOWNLOAD, stage_start);
 	} catch (std::exception &e) {
 		// 처리 불가 
 		job_log->error("[%s] Fail to download. %s", job_name, e.what());
-		gearman_job_send_warning(job, default_config.fail_download.c_str(),
-									  default_config.fail_download.size());
-		gearman_job_send_fail(job);
-		return GEARMAN_ERROR;
+		error = default_config.fail_download;
+		return false;
 	}
 
 	if (protocol == PROTOCOL_NONE) {
 		// Stream data
-		data = (short *) workload;
+		data = (const short *) workload;
 		size = workload_size / sizeof(short);
 	} else {
-		data = (short *) &*buffer.begin();
+		data = buffer.data();
 		size = buffer.size();
 	}
+	Metrics::add(COUNTER_BYTES, size * sizeof(short));
 
 	// Check WAVE format
-	int metadata_size;
+	WaveInfo wave;
 	bool is_wave = false;
 	std::string input_file, output_file;
-	switch (VRServer::check_wave_format(data, size)) {
+	stage_start = std::chrono::steady_clock::now();
+	enum WAVE_FORMAT format = VRServer::check_wave_format(data, size);
+	Metrics::observe(STAGE_FORMAT, stage_start);
+	switch (format) {
 	default:
 		// 분석 불가능한 포멧 
 		job_log->error("[%s] Unsupported format", job_name);
-		gearman_job_send_fail(job);
-		return GEARMAN_ERROR;
+		return false;
 
 	case UNKNOWN_FORMAT:
 		job_log->warn("[%s] Input data like RAW PCM", job_name);
@@ -416,13 +639,15 @@ static gearman_return_t job_stt(gearman_job_st *job, void *context) {
 
 	case STANDARD_WAVE:
 		job_log->info("[%s] Input data is Standard WAVE format", job_name);
-		metadata_size = 44 / sizeof(short);
-		data += metadata_size;
-		size -= metadata_size;
+		parse_wave((const char *) data, size * sizeof(short), wave);
+		data = (const short *) wave.data;
+		size = wave.data_size / sizeof(short);
 		break;
 
 	case WAVE:
 		is_wave = true;
+		if (__decode_wave(server, job_name, buffer, data, size, channels))
+			break;
 
 	case MPEG:
 		if (is_wave)
@@ -430,68 +655,22 @@ static gearman_return_t job_stt(gearman_job_st *job, void *context) {
 		else
 			job_log->info("[%s] Input data is MPEG-3 format", job_name);
 
-		// 로컬 파일이 아닌 경우 저장 시도 
-		//if (!__store_file(job, job_name, is_wave, data, size, workload, workload_size, protocol, input_file)) {
-		if (!__store_file(job, job_name, is_wave, data, size, get_file_nm.c_str(), workload_size, protocol, input_file)) {
-			gearman_job_send_fail(job);
-			return GEARMAN_ERROR;
-		}
-
-		// 기존 버퍼 삭제 
-		buffer.clear();
-
-		// 바이너리 호출로 대체 
-		if (server->getConfig()->isSet("stt.decoder")) {
-			std::string cmd(server->getConfig()->getConfig("stt.decoder"));
-			cmd.push_back(' ');
-			cmd.append(input_file.c_str());
-			job_log->debug("[%s] %s", job_name, cmd.c_str());
-			if (std::system(cmd.c_str())) {
-				job_log->error("[%s] Fail to decoding: %s", job_name, input_file.c_str());
-				gearman_job_send_warning(job, default_config.fail_decoding.c_str(),
-					default_config.fail_decoding.size());
-				gearman_job_send_fail(job);
-				return GEARMAN_ERROR;
-			}
-		}
-		else {
-			job_log->error("[%s] Cannot decoding: %s", job_name, input_file.c_str());
-			gearman_job_send_fail(job);
-			return GEARMAN_ERROR;
-		}
-
-		output_file = std::string(input_file.c_str(), input_file.size() - 3);
-		output_file.append("pcm");
-
-		// 파일 다시 로드 
-		if (!__load_file(output_file, buffer)) {
-			job_log->error("[%s] Cannot decoding: %s", job_name, std::strerror(errno));
-			gearman_job_send_fail(job);
-			return GEARMAN_ERROR;
+	case WAVE_2CH:	// 일반 디코딩 후 처리 하도록 수정(AIA 용)
+		if (format == WAVE_2CH && __decode_wave(server, job_name, buffer, data, size, channels)) {
+			job_log->info("[%s] Input data is 2CH WAVE", job_name);
+			break;
 		}
 
-		data = (short *) &*buffer.begin();
-		size = buffer.size();
-
-		// 임시 파일 삭제 
-		std::remove(output_file.c_str());
-		if (protocol != PROTOCOL_FILE)
-			std::remove(input_file.c_str());
-		break;
-
-
-	case WAVE_2CH:	// 일반 디코딩 후 처리 하도록 수정(AIA 용)
 		// 로컬 파일이 아닌 경우 저장 시도 
 		//if (!__store_file(job, job_name, is_wave, data, size, workload, workload_size, protocol, input_file)) {
-		if (!__store_file(job, job_name, is_wave, data, size, get_file_nm.c_str(), workload_size, protocol, input_file)) {
-			gearman_job_send_fail(job);
-			return GEARMAN_ERROR;
-		}
+		if (!__store_file(NULL, job_name, is_wave, data, size, get_file_nm.c_str(), workload_size, protocol, input_file))
+			return false;
 
 		// 기존 버퍼 삭제 
 		buffer.clear();
 
 		// 바이너리 호출로 대체 
+		stage_start = std::chrono::steady_clock::now();
 		if (server->getConfig()->isSet("stt.decoder")) {
 			std::string cmd(server->getConfig()->getConfig("stt.decoder"));
 			cmd.push_back(' ');
@@ -499,16 +678,13 @@ static gearman_return_t job_stt(gearman_job_st *job, void *context) {
 			job_log->debug("[%s] %s", job_name, cmd.c_str());
 			if (std::system(cmd.c_str())) {
 				job_log->error("[%s] Fail to decoding: %s", job_name, input_file.c_str());
-				gearman_job_send_warning(job, default_config.fail_decoding.c_str(),
-					default_config.fail_decoding.size());
-				gearman_job_send_fail(job);
-				return GEARMAN_ERROR;
+				error = default_config.fail_decoding;
+				return false;
 			}
 		}
 		else {
 			job_log->error("[%s] Cannot decoding: %s", job_name, input_file.c_str());
-			gearman_job_send_fail(job);
-			return GEARMAN_ERROR;
+			return false;
 		}
 
 		output_file = std::string(input_file.c_str(), input_file.size() - 3);
@@ -517,21 +693,18 @@ static gearman_return_t job_stt(gearman_job_st *job, void *context) {
 		// 파일 다시 로드 
 		if (!__load_file(output_file, buffer)) {
 			job_log->error("[%s] Cannot decoding: %s", job_name, std::strerror(errno));
-			gearman_job_send_fail(job);
-			return GEARMAN_ERROR;
+			return false;
 		}
 
-		data = (short *) &*buffer.begin();
+		data = buffer.data();
 		size = buffer.size();
+		Metrics::observe(STAGE_DECODE, stage_start);
 
 		// 임시 파일 삭제 
 		std::remove(output_file.c_str());
 		if (protocol != PROTOCOL_FILE)
 			std::remove(input_file.c_str());
 	}
-		
-
-
 
 	// 아래 주석 부분을 AIA 처리 부분 때문에 주석으로 처리함. 다른 사이트는 적용시 주석 해제(20171206)
 	/*
@@ -539,7 +712,7 @@ static gearman_return_t job_stt(gearman_job_st *job, void *context) {
 		job_log->info("[%s] Input data is 2CH WAVE", job_name);
 		// 로컬 파일이 아닌 경우 저장 시도 
 		if (!__store_file(job, job_name, true, data, size, workload, workload_size, protocol, input_file)) {
-				gearman_job_send_fail(job);
+				WorkerDaemon::sendFail(job);
 				return GEARMAN_ERROR;
 		}
 
@@ -553,12 +726,12 @@ static gearman_return_t job_stt(gearman_job_st *job, void *context) {
 			job_log->debug("[%s] %s", job_name, cmd.c_str());
 			if (std::system(cmd.c_str())) {
 				job_log->error("[%s] Fail to separation: %s", job_name, input_file.c_str());
-				gearman_job_send_fail(job);
+				WorkerDaemon::sendFail(job);
 				return GEARMAN_ERROR;
 			}
 		} else {
 			job_log->error("[%s] Cannot separation: %s", job_name, input_file.c_str());
-			gearman_job_send_fail(job);
+			WorkerDaemon::sendFail(job);
 			return GEARMAN_ERROR;
 		}
 
@@ -579,18 +752,17 @@ static gearman_return_t job_stt(gearman_job_st *job, void *context) {
 			// 파일 다시 로드 
 			if (!__load_file(output_file, buffer)) {
 				job_log->error("[%s] Cannot decoding: %s", job_name, std::strerror(errno));
-				gearman_job_send_warning(job, default_config.fail_decoding.c_str(),
-											  default_config.fail_decoding.size());
-				gearman_job_send_fail(job);
+				__send_error(job, default_config.fail_decoding);
+				WorkerDaemon::sendFail(job);
 				return GEARMAN_ERROR;
 			}
 
-			data = (short *) &*buffer.begin();
+			data = buffer.data();
 			size = buffer.size();
 
 			if (!__job_stt(server, data, size, part_data[ch_idx])) {
 				job_log->error("[%s] Fail to stt", job_name);
-				gearman_job_send_fail(job);
+				WorkerDaemon::sendFail(job);
 				return GEARMAN_ERROR;
 			}
 
@@ -605,7 +777,7 @@ static gearman_return_t job_stt(gearman_job_st *job, void *context) {
  		merge_data.append(part_data[1]);
 
 		job_log->debug("[%s] Done: %d bytes", job_name, merge_data.size());
-		if (gearman_failed(gearman_job_send_complete(job, merge_data.c_str(), merge_data.size()))) {
+		if (gearman_failed(WorkerDaemon::sendComplete(job, merge_data.c_str(), merge_data.size()))) {
 			job_log->error("[%s] Fail to send result", job_name);
 			return GEARMAN_ERROR;
 		}
@@ -614,23 +786,329 @@ static gearman_return_t job_stt(gearman_job_st *job, void *context) {
 	}
 	*/
 
-	// STT
-	std::string cell_data(boost::lexical_cast<std::string>(size * sizeof(short)));
-	cell_data.push_back('\n');
-	if (!__job_stt(server, data, size, cell_data)) {
+	return true;
+}
+
+/**
+ * @brief		STT 요청 
+ * @details		vr_stt_stream 으로 요청하면 결과 크기 헤더와 확정된 인식 결과를 나올 때마다
+ 				gearman_job_send_data 로 보내고, 빈 complete 로 끝낸다.
+ 				받은 data 를 이어 붙이면 vr_stt 의 결과와 같다.\n
+ 				vr_stt_bin 으로 요청하면 BINARY_RESULT_MAGIC, 음성 데이터 크기(uint32_t),
+ 				BinaryResultBlock 순으로 보낸다.\n
+ 				workload 앞에 "domain=<이름>\\n" 을 붙이면 stt.domains 의 그래프로 인식한다.
+ * @author		Kijeong Khil (kjkhil@itfact.co.kr)
+ * @date		2016. 06. 27. 13:39:27
+ * @return		Upon successful completion, a GEARMAN_SUCCESS is returned.\n
+ 				Otherwise, a GEARMAN_ERROR is returned.
+ * @see			job_unsegment()
+ */
+static gearman_return_t job_stt(gearman_job_st *job, void *context) {
+	const char *workload = (const char *) gearman_job_workload(job);
+	size_t workload_size = gearman_job_workload_size(job);
+	std::string __job_name(COLOR_BLACK_BOLD);
+	__job_name.append("STT:");
+	__job_name.append(gearman_job_handle(job));
+	__job_name.append(COLOR_NC);
+	const char *job_name = __job_name.c_str();
+	VRServer *server = (VRServer *) context;
+	const std::chrono::steady_clock::time_point job_start = std::chrono::steady_clock::now();
+
+	job_log->info("[%s] Recieved %d bytes", job_name, workload_size);
+	std::string domain;
+	if (!__take_domain(server, job_name, workload, workload_size, domain)) {
+		__send_error(job, default_config.fail_domain);
+		WorkerDaemon::sendFail(job);
+		return GEARMAN_ERROR;
+	}
+	if (workload_size < 10) {
+		job_log->error("[%s] The file size is too small (< 10 bytes)", job_name);
+		WorkerDaemon::sendFail(job);
+		return GEARMAN_ERROR;
+	}
+
+	// 음성 데이터 준비 (이진 결과는 채널 구분이 없으므로 2채널도 디코더로 변환)
+	const short *data;
+	size_t size;
+	size_t channels;
+	AudioBuffer buffer;
+	std::string error;
+	enum RESULT_FORMAT format = RESULT_TEXT;
+	if (std::strcmp(gearman_job_function_name(job), "vr_stt_bin") == 0)
+		format = RESULT_BINARY;
+	if (!__prepare_audio(server, job_name, workload, workload_size, buffer, data, size, error,
+						 format == RESULT_TEXT ? &channels : NULL)) {
+		if (!error.empty())
+			__send_error(job, error);
+		WorkerDaemon::sendFail(job);
+		return GEARMAN_ERROR;
+	}
+	if (format == RESULT_BINARY)
+		channels = 1;
+
+	// STT (채널당 크기)
+	std::string cell_data;
+	const size_t samples = size / channels;
+	if (format == RESULT_BINARY) {
+		uint32_t audio_size = static_cast<uint32_t>(samples * sizeof(short));
+		cell_data.append(BINARY_RESULT_MAGIC, sizeof(BINARY_RESULT_MAGIC));
+		cell_data.append(reinterpret_cast<const char *>(&audio_size), sizeof(audio_size));
+	} else {
+		cell_data.append(boost::lexical_cast<std::string>(samples * sizeof(short)));
+		cell_data.push_back('\n');
+	}
+	SegmentHandler on_segment;
+	if (std::strcmp(gearman_job_function_name(job), "vr_stt_stream") == 0) {
+		// 구간 결과 전송 
+		on_segment = [job, job_name](std::string &segment) {
+			if (segment.empty())
+				return true;
+			job_log->debug("[%s] Send segment: %d bytes", job_name, segment.size());
+			std::chrono::steady_clock::time_point send_start = std::chrono::steady_clock::now();
+			gearman_return_t ret = WorkerDaemon::sendData(job, segment.c_str(), segment.size());
+			Metrics::observe(STAGE_SEND, send_start);
+			if (gearman_failed(ret)) {
+				job_log->error("[%s] Fail to send segment", job_name);
+				return false;
+			}
+			return true;
+		};
+		if (!on_segment(cell_data)) {
+			WorkerDaemon::sendFail(job);
+			return GEARMAN_ERROR;
+		}
+		cell_data.clear();
+	}
+	if (!(channels == 2 ? __job_stt_stereo(server, data, size, cell_data, on_segment, domain)
+						: __job_stt(server, data, size, cell_data, on_segment, format, domain))) {
 		job_log->error("[%s] Fail to stt", job_name);
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
 
 	// 결과 전송 
 	job_log->debug("[%s] Done: %d bytes", job_name, cell_data.size());
-	gearman_return_t ret = gearman_job_send_complete(job, cell_data.c_str(), cell_data.size());
+	std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
+	gearman_return_t ret = WorkerDaemon::sendComplete(job, cell_data.c_str(), cell_data.size());
+	Metrics::observe(STAGE_SEND, stage_start);
 	if (gearman_failed(ret)) {
 		job_log->error("[%s] Fail to send result", job_name);
 		return GEARMAN_ERROR;
 	}
 
+	// 8KHz
+	if (samples)
+		Metrics::observeRTF(std::chrono::duration<double>(stage_start - job_start).count() / (samples / 8000.0));
+
+	return GEARMAN_SUCCESS;
+}
+
+/**
+ * @brief		일괄 STT 요청 
+ * @details		workload 는 한 줄에 하나씩 녹취 URI 를 나열한 목록이며, 최대 stt_batch.threads 개의 쓰레드가
+ 				나누어 처리한다. 작업 쓰레드 외의 쓰레드는 연산 풀의 빈 슬롯을 쓴다. 응답은 목록 순서대로 항목별 상태와 길이를 앞에 붙여 보낸다.\n
+ 				\<항목 수\>\\n\n
+ 				OK \<길이\>\\n\<vr_stt 결과\> 또는 ERR \<길이\>\\n\<오류 코드\> 반복\n
+ 				일부 항목이 실패해도 작업은 성공으로 응답한다.
+ 				목록 앞의 "domain=<이름>\\n" 은 모든 항목에 적용한다.
+ * @date		2026. 10. 17. 10:21:36
+ * @return		Upon successful completion, a GEARMAN_SUCCESS is returned.\n
+ 				Otherwise, a GEARMAN_ERROR is returned.
+ * @see			job_stt()
+ */
+static gearman_return_t job_stt_batch(gearman_job_st *job, void *context) {
+	const char *workload = (const char *) gearman_job_workload(job);
+	size_t workload_size = gearman_job_workload_size(job);
+	std::string __job_name(COLOR_BLACK_BOLD);
+	__job_name.append("BATCH:");
+	__job_name.append(gearman_job_handle(job));
+	__job_name.append(COLOR_NC);
+	const char *job_name = __job_name.c_str();
+	VRServer *server = (VRServer *) context;
+
+	std::string domain;
+	if (!__take_domain(server, job_name, workload, workload_size, domain)) {
+		__send_error(job, default_config.fail_domain);
+		WorkerDaemon::sendFail(job);
+		return GEARMAN_ERROR;
+	}
+
+	std::vector<std::string> items;
+	std::string manifest(workload, workload_size);
+	boost::split(items, manifest, boost::is_any_of("\r\n"), boost::token_compress_on);
+	items.erase(std::remove_if(items.begin(), items.end(),
+							   [](const std::string &item) {return item.empty();}), items.end());
+
+	job_log->info("[%s] Recieved %d item(s)", job_name, items.size());
+	if (items.empty()) {
+		job_log->error("[%s] Empty manifest", job_name);
+		WorkerDaemon::sendFail(job);
+		return GEARMAN_ERROR;
+	}
+
+	std::vector<std::string> results(items.size());
+	std::vector<char> succeeded(items.size(), false);	// 쓰레드별로 다른 항목에 기록 
+	std::atomic<std::size_t> next(0);
+	auto process = [&]() {
+		for (std::size_t i = next++; i < items.size(); i = next++) {
+			std::string item_name(job_name);
+			item_name.push_back('#');
+			item_name.append(std::to_string(i));
+
+			const short *data;
+			size_t size;
+			size_t channels;
+			AudioBuffer buffer;
+			std::string &cell_data = results[i];
+			if (items[i].size() < 10) {
+				job_log->error("[%s] The file size is too small (< 10 bytes)", item_name.c_str());
+				cell_data = default_config.fail_nofile;
+				Metrics::fail(cell_data);
+				continue;
+			}
+			if (!__prepare_audio(server, item_name.c_str(), items[i].c_str(), items[i].size(),
+								 buffer, data, size, cell_data, &channels)) {
+				if (cell_data.empty())
+					cell_data = default_config.fail_decoding;
+				Metrics::fail(cell_data);
+				continue;
+			}
+
+			cell_data = boost::lexical_cast<std::string>(size / channels * sizeof(short));
+			cell_data.push_back('\n');
+			if (!(channels == 2 ? __job_stt_stereo(server, data, size, cell_data, nullptr, domain)
+								: __job_stt(server, data, size, cell_data, nullptr, RESULT_TEXT, domain))) {
+				job_log->error("[%s] Fail to stt", item_name.c_str());
+				cell_data = default_config.fail_decoding;
+				Metrics::fail(cell_data);
+				continue;
+			}
+			succeeded[i] = true;
+		}
+	};
+
+	// 작업 쓰레드 외에는 연산 풀의 빈 슬롯에서만 처리
+	std::size_t nr_threads = static_cast<std::size_t>(server->getConfig()->getConfig("stt_batch.threads", 4));
+	nr_threads = std::max<std::size_t>(1, std::min(nr_threads, items.size()));
+	TaskGroup helpers(server);
+	for (std::size_t i = 1; i < nr_threads && helpers.spawn(process); ++i)
+		;
+	process();
+	helpers.wait();
+
+	// 결과 전송 
+	std::size_t nr_failed = 0;
+	std::string batch_data(std::to_string(items.size()));
+	batch_data.push_back('\n');
+	for (std::size_t i = 0; i < items.size(); ++i) {
+		if (!succeeded[i])
+			++nr_failed;
+		batch_data.append(succeeded[i] ? "OK " : "ERR ");
+		batch_data.append(std::to_string(results[i].size()));
+		batch_data.push_back('\n');
+		batch_data.append(results[i]);
+	}
+
+	job_log->info("[%s] Done: %d item(s), %d failed, %d bytes", job_name, items.size(), nr_failed, batch_data.size());
+	std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
+	gearman_return_t ret = WorkerDaemon::sendComplete(job, batch_data.c_str(), batch_data.size());
+	Metrics::observe(STAGE_SEND, stage_start);
+	if (gearman_failed(ret)) {
+		job_log->error("[%s] Fail to send result", job_name);
+		return GEARMAN_ERROR;
+	}
+
+	return GEARMAN_SUCCESS;
+}
+
+/**
+ * @brief		여러 그래프 STT 요청 
+ * @details		workload 앞의 "domain=<이름>,<이름>...\\n" 로 그래프를 고르며, 없으면 기본 그래프와 stt.domains 를 모두 쓴다.
+ 				특징 벡터와 음향 모델은 한 번만 계산한다(VRServer::stt_multi()). 2채널은 하나로 합쳐 인식한다.
+ 				응답은 vr_stt 와 같은 음성 데이터 크기 줄 뒤에 그래프 수와 그래프별 결과를 요청 순서대로 보낸다.\n
+ 				\<음성 데이터 크기\>\\n\<그래프 수\>\\n\n
+ 				\<도메인\> \<길이\>\\n\<vr_stt 결과\> 반복 (기본 그래프는 default)
+ * @date		2026. 10. 17. 22:14:09
+ * @return		Upon successful completion, a GEARMAN_SUCCESS is returned.\n
+ 				Otherwise, a GEARMAN_ERROR is returned.
+ * @see			job_stt()
+ */
+static gearman_return_t job_stt_multi(gearman_job_st *job, void *context) {
+	const char *workload = (const char *) gearman_job_workload(job);
+	size_t workload_size = gearman_job_workload_size(job);
+	std::string __job_name(COLOR_BLACK_BOLD);
+	__job_name.append("MULTI:");
+	__job_name.append(gearman_job_handle(job));
+	__job_name.append(COLOR_NC);
+	const char *job_name = __job_name.c_str();
+	VRServer *server = (VRServer *) context;
+	const std::chrono::steady_clock::time_point job_start = std::chrono::steady_clock::now();
+
+	job_log->info("[%s] Recieved %d bytes", job_name, workload_size);
+	std::vector<std::string> domains;
+	if (!__take_domains(server, job_name, workload, workload_size, domains)) {
+		__send_error(job, default_config.fail_domain);
+		WorkerDaemon::sendFail(job);
+		return GEARMAN_ERROR;
+	}
+	if (domains.empty())
+		domains = server->getDomains();
+	if (workload_size < 10) {
+		job_log->error("[%s] The file size is too small (< 10 bytes)", job_name);
+		WorkerDaemon::sendFail(job);
+		return GEARMAN_ERROR;
+	}
+
+	const short *data;
+	size_t size;
+	AudioBuffer buffer;
+	std::string error;
+	if (!__prepare_audio(server, job_name, workload, workload_size, buffer, data, size, error)) {
+		if (!error.empty())
+			__send_error(job, error);
+		WorkerDaemon::sendFail(job);
+		return GEARMAN_ERROR;
+	}
+
+	std::vector<std::string> results;
+	try {
+		if (server->stt_multi(data, size, domains, results)) {
+			job_log->error("[%s] Fail to stt", job_name);
+			WorkerDaemon::sendFail(job);
+			return GEARMAN_ERROR;
+		}
+	} catch (std::exception &e) {
+		job_log->error("[%s] Fail to stt, %s", job_name, e.what());
+		WorkerDaemon::sendFail(job);
+		return GEARMAN_ERROR;
+	}
+
+	// 결과 전송 
+	std::string multi_data(boost::lexical_cast<std::string>(size * sizeof(short)));
+	multi_data.push_back('\n');
+	multi_data.append(std::to_string(domains.size()));
+	multi_data.push_back('\n');
+	for (std::size_t i = 0; i < domains.size(); ++i) {
+		multi_data.append(domains[i].empty() ? "default" : domains[i]);
+		multi_data.push_back(' ');
+		multi_data.append(std::to_string(results[i].size()));
+		multi_data.push_back('\n');
+		multi_data.append(results[i]);
+	}
+
+	job_log->debug("[%s] Done: %d graphs, %d bytes", job_name, domains.size(), multi_data.size());
+	std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
+	gearman_return_t ret = WorkerDaemon::sendComplete(job, multi_data.c_str(), multi_data.size());
+	Metrics::observe(STAGE_SEND, stage_start);
+	if (gearman_failed(ret)) {
+		job_log->error("[%s] Fail to send result", job_name);
+		return GEARMAN_ERROR;
+	}
+
+	// 8KHz
+	if (size)
+		Metrics::observeRTF(std::chrono::duration<double>(stage_start - job_start).count() / (size / 8000.0));
+
 	return GEARMAN_SUCCESS;
 }
 
@@ -677,33 +1155,37 @@ static gearman_return_t job_unsegment(gearman_job_st *job, void *context) {
 	job_log->info("[%s] Recieved %d bytes", job_name, workload_size);
 	if (workload_size < 10) {
 		job_log->error("[%s] The file size is too small (< 10 bytes)", job_name);
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
 
 	// Unsegment 
 	std::string cell_data(workload, workload_size);
 	std::string text;
+	std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
 	try {
 		if (server->unsegment(cell_data, text)) {
 			job_log->error("[%s] Fail to unsegment", job_name);
-			gearman_job_send_fail(job);
+			WorkerDaemon::sendFail(job);
 			return GEARMAN_ERROR;
 		}
 	} catch(std::exception &e) {
 		job_log->error("[%s] Fail to unsegment, %s", job_name, e.what());
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	} catch(std::exception *e) {
 		job_log->error("[%s] Fail to unsegment, %s", job_name, e->what());
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
+	Metrics::observe(STAGE_POSTPROC, stage_start);
 
 	// 결과 전송 
 	job_log->debug("[%s] Done: %s", job_name, text.c_str());
 	job_log->debug("[%s] Done: %d bytes", job_name, text.size());
-	gearman_return_t ret = gearman_job_send_complete(job, text.c_str(), text.size());
+	stage_start = std::chrono::steady_clock::now();
+	gearman_return_t ret = WorkerDaemon::sendComplete(job, text.c_str(), text.size());
+	Metrics::observe(STAGE_SEND, stage_start);
 	if (gearman_failed(ret)) {
 		job_log->error("[%s] Fail to send result", job_name);
 		return GEARMAN_ERROR;
@@ -734,7 +1216,7 @@ static gearman_return_t job_unsegment_with_time(gearman_job_st *job, void *conte
 	job_log->info("[%s] Recieved %d bytes", job_name, workload_size);
 	if (workload_size < 10) {
 		job_log->error("[%s] The file size is too small (< 10 bytes)", job_name);
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
 
@@ -751,10 +1233,11 @@ static gearman_return_t job_unsegment_with_time(gearman_job_st *job, void *conte
 
 	// Unsegment 
 	std::string text = "";
+	std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
 	try {
 		if (server->unsegment_with_time(mlf_pathname, text_pathname)) {
 			job_log->error("[%s] Fail to unsegment", job_name);
-			gearman_job_send_fail(job);
+			WorkerDaemon::sendFail(job);
 			return GEARMAN_ERROR;
 		}
 
@@ -773,17 +1256,20 @@ static gearman_return_t job_unsegment_with_time(gearman_job_st *job, void *conte
 		std::remove(text_pathname.c_str());
 	} catch(std::exception &e) {
 		job_log->error("[%s] Fail to unsegment, %s", job_name, e.what());
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	} catch(std::exception *e) {
 		job_log->error("[%s] Fail to unsegment, %s", job_name, e->what());
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
+	Metrics::observe(STAGE_POSTPROC, stage_start);
 
 	// 결과 전송 
 	job_log->debug("[%s] Done: %d bytes", job_name, text.size());
-	gearman_return_t ret = gearman_job_send_complete(job, text.c_str(), text.size());
+	stage_start = std::chrono::steady_clock::now();
+	gearman_return_t ret = WorkerDaemon::sendComplete(job, text.c_str(), text.size());
+	Metrics::observe(STAGE_SEND, stage_start);
 	if (gearman_failed(ret)) {
 		job_log->error("[%s] Fail to send result", job_name);
 		return GEARMAN_ERROR;
@@ -812,7 +1298,7 @@ static gearman_return_t job_ssp(gearman_job_st *job, void *context) {
 	job_log->info("[%s] Recieved %d bytes", job_name, workload_size);
 	if (workload_size < 10) {
 		job_log->error("[%s] The file size is too small (< 10 bytes)", job_name);
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
 
@@ -856,26 +1342,31 @@ static gearman_return_t job_ssp(gearman_job_st *job, void *context) {
 	}
 
 	std::string result;
+	std::chrono::steady_clock::time_point stage_start = std::chrono::steady_clock::now();
 	try {
 		if (server->ssp(pathname, result)) {
 			job_log->error("[%s] Fail to ssp", job_name);
-			gearman_job_send_fail(job);
+			WorkerDaemon::sendFail(job);
 			return GEARMAN_ERROR;
 		}
 		std::remove(pathname.c_str());
 	} catch(std::exception &e) {
 		job_log->error("[%s] Fail to ssp, %s", job_name, e.what());
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	} catch(std::exception *e) {
 		job_log->error("[%s] Fail to ssp, %s", job_name, e->what());
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
 
+	Metrics::observe(STAGE_POSTPROC, stage_start);
+
 	// 결과 전송 
 	job_log->debug("[%s] Done: %d bytes", job_name, result.size());
-	gearman_return_t ret = gearman_job_send_complete(job, result.c_str(), result.size());
+	stage_start = std::chrono::steady_clock::now();
+	gearman_return_t ret = WorkerDaemon::sendComplete(job, result.c_str(), result.size());
+	Metrics::observe(STAGE_SEND, stage_start);
 	if (gearman_failed(ret)) {
 		job_log->error("[%s] Fail to send result", job_name);
 		return GEARMAN_ERROR;
@@ -905,7 +1396,7 @@ static gearman_return_t job_rt_stt(gearman_job_st *job, void *context) {
 	job_log->info("[%s] Recieved %d bytes", job_name, workload_size);
 	if (workload_size < 10) {
 		job_log->error("[%s] The file size is too small (< 5 bytes)", job_name);
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
 
@@ -915,7 +1406,7 @@ static gearman_return_t job_rt_stt(gearman_job_st *job, void *context) {
 	tmp = strchr(tmp, '|');
 	if (tmp == NULL) {
 		job_log->error("[%s] Cannot find Call ID", job_name);
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
 
@@ -925,7 +1416,7 @@ static gearman_return_t job_rt_stt(gearman_job_st *job, void *context) {
 	tmp = strchr(tmp + 1, '|');
 	if (tmp == NULL) {
 		job_log->error("[%s] Invalid argument", job_name);
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
 
@@ -965,7 +1456,7 @@ static gearman_return_t job_rt_stt(gearman_job_st *job, void *context) {
 	std::string cell_data = "";
 	if (server->stt(call_id, data, size, (const char)state, cell_data) == EXIT_FAILURE) {
 		job_log->error("[%s] Fail to stt", job_name);
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
 
@@ -976,21 +1467,21 @@ static gearman_return_t job_rt_stt(gearman_job_st *job, void *context) {
 	try {
 		if (server->unsegment(cell_data, text)) {
 			job_log->error("[%s] Fail to unsegment", job_name);
-			gearman_job_send_fail(job);
+			WorkerDaemon::sendFail(job);
 			return GEARMAN_ERROR;
 		}
 	} catch(std::exception &e) {
 		job_log->error("[%s] Fail to unsegment, %s", job_name, e.what());
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	} catch(std::exception *e) {
 		job_log->error("[%s] Fail to unsegment, %s", job_name, e->what());
-		gearman_job_send_fail(job);
+		WorkerDaemon::sendFail(job);
 		return GEARMAN_ERROR;
 	}
-	gearman_return_t ret = gearman_job_send_complete(job, text.c_str(), text.size());
+	gearman_return_t ret = WorkerDaemon::sendComplete(job, text.c_str(), text.size());
 #else
-	gearman_return_t ret = gearman_job_send_complete(job, cell_data.c_str(), cell_data.size());
+	gearman_return_t ret = WorkerDaemon::sendComplete(job, cell_data.c_str(), cell_data.size());
 #endif
 
 	if (gearman_failed(ret)) {
@@ -0,0 +1,491 @@
+/**
+ * @file	vr_bench.cc
+ * @brief	VR 인식 벤치마크
+ * @details	Gearman 없이 VRServer 를 적재하고 녹취 파일을 직접 인식한다.\n
+ 			chunks	같은 녹취를 순차 인식과 구간 병렬 인식으로 처리하여 속도와
+ 					구간 경계 주변의 인식 결과 차이를 비교한다.\n
+ 			resample	PcmConverter 의 단일 코어 처리 속도(입력 샘플/초)를 표본화율과 채널별로 측정한다.\n
+ 			corpus	녹취 파일(디렉토리)을 1 부터 N 쓰레드까지 VRServer::stt() 로 인식하여 파일별/전체 실시간 배율,
+ 					단계별 처리 시간, 최대 RSS 와 쓰레드 수에 따른 확장 효율을 출력한다.
+ * @date	2026. 10. 17. 14:40:12
+ * @see		vr.cc
+ */
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "vr.hpp"
+#include "audio.hpp"
+
+using namespace itfact::vr::node;
+
+/**
+ * @brief	인식 결과의 단어
+ */
+struct Word {
+	std::size_t start;
+	std::size_t end;
+	std::string word;
+};
+
+/**
+ * @brief	벤치마크 옵션
+ */
+struct BenchOptions {
+	std::string mode;
+	std::string config_file;
+	std::string verbose = "WARNING";
+	std::size_t join_window = 100;		///< 구간 경계 앞뒤로 비교할 프레임 (10ms/frame)
+	std::size_t duration = 60;			///< resample: 표본화율별 입력 길이 (sec)
+	std::size_t block = 20;				///< resample: 블록 길이 (msec)
+	std::size_t threads = 1;			///< corpus: 최대 쓰레드 수
+	std::vector<std::string> files;
+};
+
+static void usage(const char *name) {
+	std::fprintf(stderr,
+		"Usage: %s chunks -i <config-file> [-w <join window msec>] [--verbose <level>] <file>...\n"
+		"       %s resample [-d <seconds>] [-b <block msec>]\n"
+		"       %s corpus -i <config-file> [-t <threads>] [--verbose <level>] <file or directory>...\n"
+		"  file: mono or stereo WAVE (PCM, float, G.711) or 8kHz 16bit RAW PCM\n", name, name, name);
+}
+
+static bool parse_options(const int argc, const char *argv[], BenchOptions &options) {
+	if (argc < 2)
+		return false;
+	options.mode = argv[1];
+	for (int i = 2; i < argc; ++i) {
+		std::string arg(argv[i]);
+		if ((arg == "-i" || arg == "-w" || arg == "-d" || arg == "-b" || arg == "-t" || arg == "--verbose") &&
+			i + 1 >= argc)
+			return false;
+		if (arg == "-i")
+			options.config_file = argv[++i];
+		else if (arg == "-w")
+			options.join_window = std::strtoul(argv[++i], NULL, 10) / 10;
+		else if (arg == "-d")
+			options.duration = std::strtoul(argv[++i], NULL, 10);
+		else if (arg == "-b")
+			options.block = std::strtoul(argv[++i], NULL, 10);
+		else if (arg == "-t")
+			options.threads = std::strtoul(argv[++i], NULL, 10);
+		else if (arg == "--verbose")
+			options.verbose = argv[++i];
+		else
+			options.files.push_back(arg);
+	}
+	if (options.mode == "resample")
+		return options.duration > 0 && options.block > 0;
+	return !options.config_file.empty() && !options.files.empty() && options.threads > 0;
+}
+
+/**
+ * @brief		녹취 파일 적재
+ * @details		WAVE 는 job_stt 와 같이 decode_wave() 로 변환하고, PcmConverter 로 8kHz 단일 채널로 바꾼다.
+ * @param[in]	path	파일 경로
+ * @param[out]	pcm		16bit PCM
+ * @return		지원하지 않는 형식이면 false
+ */
+static bool load_audio(const std::string &path, std::vector<short> &pcm) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+		return false;
+	std::vector<char> bytes(static_cast<std::size_t>(file.tellg()));
+	file.seekg(0);
+	if (!file.read(bytes.data(), bytes.size()))
+		return false;
+
+	WaveInfo wave;
+	if (parse_wave(bytes.data(), bytes.size(), wave)) {
+		std::vector<char> decoded;
+		if (wave.channels > 2 || wave.sample_rate == 0 || !decode_wave(wave, decoded))
+			return false;
+		PcmConverter converter(wave.sample_rate, wave.channels);
+		pcm.clear();
+		converter.process(reinterpret_cast<const short *>(decoded.data()), decoded.size() / sizeof(short), pcm);
+		converter.flush(pcm);
+		return true;
+	} else if (bytes.size() >= 4 && std::strncmp(bytes.data(), "RIFF", 4) == 0) {
+		return false;
+	}
+
+	const short *samples = reinterpret_cast<const short *>(bytes.data());
+	pcm.assign(samples, samples + bytes.size() / sizeof(short));
+	return true;
+}
+
+/**
+ * @brief		텍스트 결과를 단어 목록으로 변환
+ * @details		"<s>", "</s>" 와 같은 묵음 표시는 비교에서 제외한다.
+ */
+static std::vector<Word> parse_result(const std::string &result) {
+	std::vector<Word> words;
+	std::istringstream lines(result);
+	std::string line;
+	while (std::getline(lines, line)) {
+		std::istringstream fields(line);
+		Word word;
+		if (!(fields >> word.start >> word.end >> word.word))
+			continue;
+		if (word.word.empty() || word.word[0] == '<')
+			continue;
+		words.push_back(word);
+	}
+	return words;
+}
+
+/**
+ * @brief	단어 열 편집 거리
+ */
+static std::size_t edit_distance(const std::vector<const Word *> &ref, const std::vector<const Word *> &hyp) {
+	std::vector<std::size_t> previous(hyp.size() + 1), current(hyp.size() + 1);
+	for (std::size_t j = 0; j <= hyp.size(); ++j)
+		previous[j] = j;
+	for (std::size_t i = 1; i <= ref.size(); ++i) {
+		current[0] = i;
+		for (std::size_t j = 1; j <= hyp.size(); ++j) {
+			std::size_t cost = (ref[i - 1]->word == hyp[j - 1]->word) ? 0 : 1;
+			current[j] = std::min(std::min(previous[j] + 1, current[j - 1] + 1), previous[j - 1] + cost);
+		}
+		previous.swap(current);
+	}
+	return previous[hyp.size()];
+}
+
+/**
+ * @brief	[begin, end] 프레임과 겹치는 단어
+ */
+static std::vector<const Word *> select_words(const std::vector<Word> &words,
+											  const std::size_t begin, const std::size_t end) {
+	std::vector<const Word *> selected;
+	for (auto &word : words) {
+		if (word.end >= begin && word.start <= end)
+			selected.push_back(&word);
+	}
+	return selected;
+}
+
+static double elapsed_since(const std::chrono::steady_clock::time_point &start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief		순차 인식과 구간 병렬 인식 비교
+ * @details		두 결과 전체의 단어 편집 거리와, 구간 경계 앞뒤 join_window 프레임 안의 편집 거리를
+ 				순차 인식 결과의 단어 수에 대한 비율로 출력한다.
+ */
+static int run_chunks(VRServer &server, const BenchOptions &options) {
+	if (!server.getChunkLength()) {
+		std::fprintf(stderr, "stt.chunk_length is not set\n");
+		return EXIT_FAILURE;
+	}
+
+	double total_audio = 0, total_sequential = 0, total_chunked = 0;
+	std::size_t total_words = 0, total_errors = 0, join_words = 0, join_errors = 0, joins = 0;
+	std::printf("%-32s %8s %6s %9s %9s %7s %11s %11s\n",
+				"file", "audio(s)", "chunks", "seq(s)", "chunk(s)", "speedup", "diff", "join diff");
+	for (auto &path : options.files) {
+		std::vector<short> pcm;
+		if (!load_audio(path, pcm)) {
+			std::fprintf(stderr, "%s: unsupported format\n", path.c_str());
+			continue;
+		}
+
+		std::string sequential, chunked;
+		auto start = std::chrono::steady_clock::now();
+		if (server.stt_segment(pcm.data(), pcm.size(), sequential, nullptr, RESULT_TEXT, 0) != EXIT_SUCCESS) {
+			std::fprintf(stderr, "%s: sequential decoding failed\n", path.c_str());
+			continue;
+		}
+		double sequential_time = elapsed_since(start);
+
+		start = std::chrono::steady_clock::now();
+		if (server.stt_chunked(pcm.data(), pcm.size(), chunked) != EXIT_SUCCESS) {
+			std::fprintf(stderr, "%s: chunked decoding failed\n", path.c_str());
+			continue;
+		}
+		double chunked_time = elapsed_since(start);
+
+		// stt_chunked() 와 같은 경계
+		std::vector<std::size_t> bounds = VRServer::split_at_silence(pcm.data(), pcm.size(),
+							server.getChunkLength(), server.getChunkWindow());
+		std::vector<Word> ref = parse_result(sequential), hyp = parse_result(chunked);
+		std::size_t file_errors = edit_distance(select_words(ref, 0, SIZE_MAX), select_words(hyp, 0, SIZE_MAX));
+		std::size_t file_join_words = 0, file_join_errors = 0;
+		for (std::size_t i = 1; i + 1 < bounds.size(); ++i) {
+			std::size_t frame = bounds[i] / 80;
+			std::size_t begin = frame > options.join_window ? frame - options.join_window : 0;
+			std::vector<const Word *> ref_words = select_words(ref, begin, frame + options.join_window);
+			file_join_words += ref_words.size();
+			file_join_errors += edit_distance(ref_words, select_words(hyp, begin, frame + options.join_window));
+		}
+
+		double audio = pcm.size() / 8000.0;
+		std::printf("%-32s %8.1f %6lu %9.2f %9.2f %6.2fx %5lu/%-5lu %5lu/%-5lu\n",
+					path.c_str(), audio, bounds.size() - 1, sequential_time, chunked_time,
+					chunked_time > 0 ? sequential_time / chunked_time : 0.0,
+					file_errors, ref.size(), file_join_errors, file_join_words);
+
+		total_audio += audio;
+		total_sequential += sequential_time;
+		total_chunked += chunked_time;
+		total_words += ref.size();
+		total_errors += file_errors;
+		join_words += file_join_words;
+		join_errors += file_join_errors;
+		joins += bounds.size() - 2;
+	}
+
+	std::printf("\naudio %.1fs, joins %lu\n", total_audio, joins);
+	std::printf("sequential RTF %.4f, chunked RTF %.4f, speedup %.2fx\n",
+				total_audio > 0 ? total_sequential / total_audio : 0.0,
+				total_audio > 0 ? total_chunked / total_audio : 0.0,
+				total_chunked > 0 ? total_sequential / total_chunked : 0.0);
+	std::printf("word diff %.2f%% (%lu/%lu), join diff %.2f%% (%lu/%lu, +-%lu ms)\n",
+				total_words ? 100.0 * total_errors / total_words : 0.0, total_errors, total_words,
+				join_words ? 100.0 * join_errors / join_words : 0.0, join_errors, join_words,
+				options.join_window * 10);
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief		표본화율 변환 속도 측정
+ * @details		잡음을 섞은 정현파를 블록 단위로 PcmConverter 에 넣고, 한 쓰레드에서 처리한
+ 				입력 샘플 수(모든 채널 합)를 경과 시간으로 나눈다.
+ */
+static int run_resample(const BenchOptions &options) {
+	const uint32_t rates[] = {8000, 11025, 16000, 22050, 32000, 44100, 48000};
+	std::printf("%-8s %8s %12s %14s %10s\n", "rate", "channels", "time(s)", "samples/s", "x realtime");
+	for (auto rate : rates) {
+		for (std::size_t channels = 1; channels <= 2; ++channels) {
+			std::vector<short> input(rate * options.duration * channels);
+			std::srand(rate);
+			for (std::size_t i = 0; i < input.size(); ++i)
+				input[i] = static_cast<short>(8000 * std::sin(2 * M_PI * 440.0 * (i / channels) / rate) +
+											  std::rand() % 2001 - 1000);
+
+			PcmConverter converter(rate, channels);
+			std::vector<short> output;
+			output.reserve(input.size() / channels * PcmConverter::OUTPUT_RATE / rate + 1);
+			const std::size_t block = std::max<std::size_t>(rate * options.block / 1000 * channels, 1);
+			auto start = std::chrono::steady_clock::now();
+			for (std::size_t offset = 0; offset < input.size(); offset += block) {
+				converter.process(input.data() + offset, std::min(block, input.size() - offset), output);
+				if (output.size() > PcmConverter::OUTPUT_RATE)
+					output.clear();
+			}
+			converter.flush(output);
+			double elapsed = elapsed_since(start);
+
+			std::printf("%-8u %8lu %12.4f %14.0f %9.0fx\n", rate, channels, elapsed,
+						elapsed > 0 ? input.size() / elapsed : 0.0,
+						elapsed > 0 ? options.duration / elapsed : 0.0);
+		}
+	}
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief		인식할 파일 목록
+ * @details		디렉토리는 하위 디렉토리까지 모든 파일을 이름순으로 넣는다.
+ */
+static std::vector<std::string> list_files(const std::vector<std::string> &paths) {
+	namespace fs = boost::filesystem;
+	std::vector<std::string> files;
+	for (auto &path : paths) {
+		boost::system::error_code ec;
+		if (!fs::is_directory(path, ec)) {
+			files.push_back(path);
+			continue;
+		}
+		std::vector<std::string> entries;
+		for (fs::recursive_directory_iterator it(path, ec), end; !ec && it != end; it.increment(ec)) {
+			if (fs::is_regular_file(it->status()))
+				entries.push_back(it->path().string());
+		}
+		std::sort(entries.begin(), entries.end());
+		files.insert(files.end(), entries.begin(), entries.end());
+	}
+	return files;
+}
+
+/**
+ * @brief	최대 RSS 초기화
+ * @details	/proc/self/clear_refs 에 5 를 쓰면 VmHWM 이 현재 RSS 로 돌아간다. (Linux 4.0 이상)
+ */
+static void reset_peak_rss() {
+	std::ofstream clear_refs("/proc/self/clear_refs");
+	clear_refs << "5";
+}
+
+/**
+ * @brief	마지막 reset_peak_rss() 이후 최대 RSS (KiB)
+ */
+static std::size_t peak_rss() {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return std::strtoul(line.c_str() + 6, NULL, 10);
+	}
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return static_cast<std::size_t>(usage.ru_maxrss);
+}
+
+/**
+ * @brief	쓰레드 수 하나의 측정 결과
+ */
+struct CorpusRun {
+	std::size_t threads = 1;
+	double wall = 0;
+	std::size_t failed = 0;
+	std::size_t peak_rss = 0;			///< KiB
+	std::vector<double> seconds;		///< 파일별 인식 시간
+	double stages[STAGE_MAX];			///< 단계별 처리 시간 (모든 쓰레드 합)
+};
+
+/**
+ * @brief		녹취 파일을 run.threads 개 쓰레드로 나누어 인식
+ * @details		각 쓰레드는 남은 파일을 하나씩 가져가 VRServer::stt() 로 인식한다.
+ */
+static void run_corpus_once(VRServer &server, const std::vector<std::vector<short>> &corpus, CorpusRun &run) {
+	double before[STAGE_MAX];
+	for (std::size_t s = 0; s < STAGE_MAX; ++s)
+		before[s] = Metrics::stageSeconds(static_cast<enum METRIC_STAGE>(s));
+	run.seconds.assign(corpus.size(), 0.0);
+	reset_peak_rss();
+
+	std::atomic<std::size_t> next(0), failed(0);
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> workers;
+	for (std::size_t t = 0; t < run.threads; ++t) {
+		workers.emplace_back([&] {
+			for (std::size_t i = next++; i < corpus.size(); i = next++) {
+				std::string result;
+				auto file_start = std::chrono::steady_clock::now();
+				if (server.stt(corpus[i].data(), corpus[i].size(), result) != EXIT_SUCCESS)
+					++failed;
+				run.seconds[i] = elapsed_since(file_start);
+			}
+		});
+	}
+	for (auto &worker : workers)
+		worker.join();
+	run.wall = elapsed_since(start);
+	run.failed = failed;
+	run.peak_rss = peak_rss();
+	for (std::size_t s = 0; s < STAGE_MAX; ++s)
+		run.stages[s] = Metrics::stageSeconds(static_cast<enum METRIC_STAGE>(s)) - before[s];
+}
+
+/**
+ * @brief		처리량 측정
+ * @details		녹취 파일은 미리 모두 적재하여 디코딩 시간을 빼고, 1, 2, 4, ..., threads 쓰레드로 같은 파일들을
+ 				인식한다. 확장 효율은 (1 쓰레드 경과 시간 / N 쓰레드 경과 시간) / N 이다.
+ 				단계별 시간은 모든 쓰레드의 합이며, setup 에는 처음 만드는 디코더 컨텍스트가 포함된다.
+ */
+static int run_corpus(VRServer &server, const BenchOptions &options) {
+	std::vector<std::string> names;
+	std::vector<std::vector<short>> corpus;
+	double total_audio = 0;
+	for (auto &path : list_files(options.files)) {
+		std::vector<short> pcm;
+		if (!load_audio(path, pcm) || pcm.empty()) {
+			std::fprintf(stderr, "%s: unsupported format\n", path.c_str());
+			continue;
+		}
+		total_audio += pcm.size() / 8000.0;
+		names.push_back(path);
+		corpus.push_back(std::move(pcm));
+	}
+	if (corpus.empty()) {
+		std::fprintf(stderr, "No audio to decode\n");
+		return EXIT_FAILURE;
+	}
+	std::printf("%lu files, audio %.1fs, RSS after loading %.1f MiB\n\n",
+				corpus.size(), total_audio, peak_rss() / 1024.0);
+
+	std::vector<CorpusRun> runs;
+	for (std::size_t threads = 1; ; threads *= 2) {
+		runs.emplace_back();
+		runs.back().threads = std::min(threads, options.threads);
+		run_corpus_once(server, corpus, runs.back());
+		if (threads >= options.threads)
+			break;
+	}
+	const CorpusRun &first = runs.front(), &last = runs.back();
+
+	std::printf("%-40s %8s %10s %10s\n", "file", "audio(s)", "RTF(1)", "RTF(N)");
+	for (std::size_t i = 0; i < corpus.size(); ++i) {
+		double audio = corpus[i].size() / 8000.0;
+		std::printf("%-40s %8.1f %10.4f %10.4f\n", names[i].c_str(), audio,
+					first.seconds[i] / audio, last.seconds[i] / audio);
+	}
+
+	std::printf("\n%7s %9s %8s %11s %10s %7s %13s\n",
+				"threads", "wall(s)", "RTF", "x realtime", "efficiency", "failed", "peak RSS(MiB)");
+	for (auto &run : runs) {
+		std::printf("%7lu %9.2f %8.4f %10.1fx %9.1f%% %7lu %13.1f\n", run.threads, run.wall,
+					run.wall / total_audio, run.wall > 0 ? total_audio / run.wall : 0.0,
+					run.wall > 0 ? 100.0 * first.wall / run.wall / run.threads : 0.0,
+					run.failed, run.peak_rss / 1024.0);
+	}
+
+	std::printf("\n%-10s", "stage(s)");
+	for (auto &run : runs)
+		std::printf(" %9lu", run.threads);
+	std::printf("\n");
+	for (std::size_t s = 0; s < STAGE_MAX; ++s) {
+		bool used = false;
+		for (auto &run : runs)
+			used = used || run.stages[s] > 0;
+		if (!used)
+			continue;
+		std::printf("%-10s", Metrics::stageName(static_cast<enum METRIC_STAGE>(s)));
+		for (auto &run : runs)
+			std::printf(" %9.2f", run.stages[s]);
+		std::printf("\n");
+	}
+	return last.failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int main(const int argc, char const *argv[]) {
+	BenchOptions options;
+	if (!parse_options(argc, argv, options) ||
+		(options.mode != "chunks" && options.mode != "resample" && options.mode != "corpus")) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	if (options.mode == "resample")
+		return run_resample(options);
+
+	try {
+		const char *server_argv[] = {argv[0], "-i", options.config_file.c_str(),
+									 "--verbose", options.verbose.c_str()};
+		VRServer server(sizeof(server_argv) / sizeof(server_argv[0]), server_argv);
+		if (!server.load()) {
+			std::fprintf(stderr, "Fail to load STT engine\n");
+			return EXIT_FAILURE;
+		}
+		if (options.mode == "corpus")
+			return run_corpus(server, options);
+		return run_chunks(server, options);
+	} catch (std::exception &e) {
+		perror(e.what());
+		return EXIT_FAILURE;
+	}
+}
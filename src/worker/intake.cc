@@ -0,0 +1,566 @@
+/**
+ * @file	intake.cc
+ * @brief	Event driven job intake
+ * @details	I/O 쓰레드는 gearman 서버에서 작업을 가져오기만 하고, 실제 처리는 공유 연산 풀에서 수행한다.\n
+ 			연산 풀에 여유가 없으면 작업을 가져오지 않으므로 서버에 작업이 대기하게 된다.
+ * @date	2026. 10. 16. 13:20:41
+ * @see		worker.cc
+ */
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <algorithm>
+#include <queue>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "worker.hpp"
+
+using namespace itfact::worker;
+
+namespace itfact {
+	namespace worker {
+		/**
+		 * @brief	작업 처리용 공유 쓰레드 풀
+		 */
+		class ComputePool : private boost::noncopyable
+		{
+		private: // Member
+			std::vector<std::thread> threads;
+			std::queue<std::function<void()>> tasks;
+			std::mutex lock;
+			std::condition_variable cv;
+			std::atomic<std::size_t> reserved;
+			std::size_t capacity;
+			bool stopping = false;
+
+		public:
+			explicit ComputePool(const std::size_t size) : reserved(0), capacity(size ? size : 1) {
+				for (std::size_t i = 0; i < capacity; ++i)
+					threads.push_back(std::thread(&ComputePool::loop, this));
+			};
+			~ComputePool() {stop();};
+
+			/// 처리 슬롯 예약. 빈 슬롯이 없으면 false
+			bool reserve() {
+				std::size_t current = reserved.load();
+				while (current < capacity) {
+					if (reserved.compare_exchange_weak(current, current + 1))
+						return true;
+				}
+				return false;
+			};
+			/// 예약 해제
+			void release() {--reserved;};
+			std::size_t getCapacity() const {return capacity;};
+			/// 예약된 슬롯에 작업 추가. 작업이 끝나면 release() 를 호출해야 함
+			void submit(std::function<void()> task) {
+				std::lock_guard<std::mutex> guard(lock);
+				tasks.push(std::move(task));
+				cv.notify_one();
+			};
+			void stop() {
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					if (stopping)
+						return;
+					stopping = true;
+				}
+				cv.notify_all();
+				for (auto &thread : threads)
+					thread.join();
+			};
+
+		private:
+			void loop() {
+				while (true) {
+					std::function<void()> task;
+					{
+						std::unique_lock<std::mutex> guard(lock);
+						cv.wait(guard, [this] {return stopping || !tasks.empty();});
+						if (tasks.empty())
+							return;
+						task = std::move(tasks.front());
+						tasks.pop();
+					}
+					task();
+				}
+			};
+		};
+
+		/**
+		 * @brief	작업을 가져온 I/O 쓰레드에 전달할 응답
+		 */
+		struct JobReply {
+			enum Type {
+				REPLY_DATA,
+				REPLY_WARNING,
+				REPLY_COMPLETE,
+				REPLY_FAIL,
+				REPLY_RELEASE	///< 작업 종료. 완료 응답이 없었으면 결과에 따라 응답 후 해제
+			} type;
+			gearman_job_st *job;
+			std::string payload;
+			gearman_return_t result;
+			bool finished;	///< 완료 또는 실패 응답 여부
+		};
+
+		/**
+		 * @brief	gearman 작업 수신 루프
+		 * @details	libgearman 은 연결 소켓을 외부로 노출하지 않으므로, 서버 대기는
+		 			gearman_worker_wait() 에 짧은 타임아웃을 주어 처리하고,
+		 			연산 풀의 응답은 eventfd 로 깨워서 전송한다.\n
+		 			워커가 non-blocking 이므로 소켓이 가득 차면 전송하지 못한 응답을 대기열 앞에 두고,
+		 			gearman_worker_wait() 로 소켓이 쓰기 가능해진 뒤 이어서 전송한다.
+		 */
+		class IntakeLoop : private boost::noncopyable
+		{
+		private: // Member
+			std::deque<JobReply> replies;
+			std::deque<JobReply> unsent;	///< I/O 쓰레드 전용. 앞에서부터 차례로 전송
+			std::mutex lock;
+			int event_fd = -1;
+			int epoll_fd = -1;
+
+		public:
+			IntakeLoop() {
+				event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+				epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+				if (event_fd < 0 || epoll_fd < 0)
+					throw std::runtime_error(std::strerror(errno));
+
+				struct epoll_event ev;
+				std::memset(&ev, 0, sizeof(ev));
+				ev.events = EPOLLIN;
+				ev.data.fd = event_fd;
+				if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, event_fd, &ev) < 0)
+					throw std::runtime_error(std::strerror(errno));
+			};
+			~IntakeLoop() {
+				if (epoll_fd >= 0)
+					close(epoll_fd);
+				if (event_fd >= 0)
+					close(event_fd);
+			};
+
+			void post(JobReply &&reply) {
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					replies.push_back(std::move(reply));
+				}
+				uint64_t one = 1;
+				if (write(event_fd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+					throw std::runtime_error(std::strerror(errno));
+			};
+
+			/// 응답 대기. 타임아웃 또는 응답 수신 시 반환
+			void wait(const int timeout) {
+				struct epoll_event ev;
+				if (epoll_wait(epoll_fd, &ev, 1, timeout) > 0) {
+					uint64_t count;
+					if (read(event_fd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+						throw std::runtime_error(std::strerror(errno));
+				}
+			};
+
+			/// 소켓이 쓰기 가능해지기를 기다리는 응답 여부
+			bool isBlocked() const {return !unsent.empty();};
+
+			/**
+			 * @brief	대기중인 응답 전송
+			 * @details	GEARMAN_IO_WAIT 이면 (일부만 전송된 경우 포함) 해당 응답부터 남겨두고 중단한다.
+			 			libgearman 은 같은 작업의 전송 함수를 다시 호출하면 남은 부분부터 이어서 보낸다.
+			 * @return	마지막 응답까지 전송되어 해제된 작업 수
+			 */
+			std::size_t flush(log4cpp::Category *logger) {
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					for (auto &reply : replies)
+						unsent.push_back(std::move(reply));
+					replies.clear();
+				}
+
+				std::size_t released = 0;
+				while (!unsent.empty()) {
+					JobReply &reply = unsent.front();
+					gearman_return_t ret = GEARMAN_SUCCESS;
+					switch (reply.type) {
+					case JobReply::REPLY_DATA:
+						ret = gearman_job_send_data(reply.job, reply.payload.data(), reply.payload.size());
+						break;
+					case JobReply::REPLY_WARNING:
+						ret = gearman_job_send_warning(reply.job, reply.payload.data(), reply.payload.size());
+						break;
+					case JobReply::REPLY_COMPLETE:
+						ret = gearman_job_send_complete(reply.job, reply.payload.data(), reply.payload.size());
+						break;
+					case JobReply::REPLY_FAIL:
+						ret = gearman_job_send_fail(reply.job);
+						break;
+					case JobReply::REPLY_RELEASE:
+						if (!reply.finished) {	// 완료 응답 없이 종료된 작업
+							if (reply.result == GEARMAN_SUCCESS)
+								ret = gearman_job_send_complete(reply.job, NULL, 0);
+							else
+								ret = gearman_job_send_fail(reply.job);
+						}
+						break;
+					}
+					if (ret == GEARMAN_IO_WAIT)
+						break;
+					if (gearman_failed(ret))
+						logger->error("[%s] %s", gearman_job_handle(reply.job), gearman_strerror(ret));
+
+					if (reply.type == JobReply::REPLY_RELEASE) {
+						gearman_job_free(reply.job);
+						++released;
+					}
+					unsent.pop_front();
+				}
+				return released;
+			};
+		};
+	}
+}
+
+/// 현재 쓰레드가 처리중인 작업의 I/O 쓰레드. 연산 풀 외의 쓰레드에서는 NULL
+static thread_local IntakeLoop *current_loop = NULL;
+/// 현재 작업의 완료 응답 여부
+static thread_local bool current_finished = false;
+
+/**
+ * @brief		결과 응답 전달
+ * @date		2026. 10. 16. 13:42:10
+ * @return		event 모드에서는 전송 대기열에 추가되면 GEARMAN_SUCCESS
+ */
+static gearman_return_t
+send_reply(const JobReply::Type type, gearman_job_st *job, const void *data, const size_t data_size) {
+	if (type == JobReply::REPLY_COMPLETE || type == JobReply::REPLY_FAIL)
+		current_finished = true;
+
+	JobReply reply;
+	reply.type = type;
+	reply.job = job;
+	reply.result = GEARMAN_SUCCESS;
+	reply.finished = false;
+	if (data && data_size)
+		reply.payload.assign((const char *) data, data_size);
+	current_loop->post(std::move(reply));
+	return GEARMAN_SUCCESS;
+}
+
+gearman_return_t WorkerDaemon::sendComplete(gearman_job_st *job, const void *result, const size_t result_size) {
+	if (current_loop)
+		return send_reply(JobReply::REPLY_COMPLETE, job, result, result_size);
+	return gearman_job_send_complete(job, result, result_size);
+}
+
+gearman_return_t WorkerDaemon::sendData(gearman_job_st *job, const void *data, const size_t data_size) {
+	if (current_loop)
+		return send_reply(JobReply::REPLY_DATA, job, data, data_size);
+	return gearman_job_send_data(job, data, data_size);
+}
+
+gearman_return_t WorkerDaemon::sendWarning(gearman_job_st *job, const void *warning, const size_t warning_size) {
+	if (current_loop)
+		return send_reply(JobReply::REPLY_WARNING, job, warning, warning_size);
+	return gearman_job_send_warning(job, warning, warning_size);
+}
+
+gearman_return_t WorkerDaemon::sendFail(gearman_job_st *job) {
+	if (current_loop)
+		return send_reply(JobReply::REPLY_FAIL, job, NULL, 0);
+	return gearman_job_send_fail(job);
+}
+
+/**
+ * @brief		연산 풀에서 작업 실행
+ * @date		2026. 10. 16. 13:47:55
+ */
+static void
+run_job(ComputePool *pool, IntakeLoop *loop, const JobFunction *function, gearman_job_st *job,
+		log4cpp::Category *logger) {
+	gearman_return_t ret = GEARMAN_ERROR;
+
+	current_loop = loop;
+	current_finished = false;
+	try {
+		ret = WorkerDaemon::execute(job, (void *) function);
+	} catch (std::exception &e) {
+		logger->error("[%s] Error detected. %s", function->name.c_str(), e.what());
+	}
+
+	JobReply reply;
+	reply.type = JobReply::REPLY_RELEASE;
+	reply.job = job;
+	reply.result = ret;
+	reply.finished = current_finished;
+	current_loop = NULL;
+
+	// 응답을 받은 I/O 쓰레드가 바로 다음 작업을 가져올 수 있도록 먼저 해제
+	pool->release();
+	loop->post(std::move(reply));
+}
+
+/**
+ * @brief		I/O 쓰레드용 워커 생성 및 함수 등록
+ * @date		2026. 10. 17. 09:48:15
+ * @return		생성된 워커. 실패 시 NULL
+ */
+static std::shared_ptr<gearman_worker_st>
+create_intake_worker(const std::vector<JobServer> &servers, const int timeout,
+					 const std::vector<JobFunction> *functions, log4cpp::Category *logger) {
+	std::shared_ptr<gearman_worker_st> worker;
+	gearman_worker_st *worker_st = gearman_worker_create(NULL);
+	if (worker_st == NULL) {
+		logger->fatal("[intake] Memory allocation failure on worker creation");
+		return worker;
+	}
+	worker.reset(worker_st, gearman_worker_free);
+
+	for (auto &server : servers) {
+		gearman_return_t ret = gearman_worker_add_server(worker.get(), server.host.c_str(), server.port);
+		if (ret != GEARMAN_SUCCESS) {
+			logger->error("[intake] %s", gearman_worker_error(worker.get()));
+			worker.reset();
+			return worker;
+		}
+	}
+	gearman_worker_add_options(worker.get(), GEARMAN_WORKER_NON_BLOCKING);
+
+	for (auto &function : *functions) {
+		gearman_return_t ret = gearman_worker_register(worker.get(), function.name.c_str(), timeout < 0 ? 0 : timeout);
+		if (gearman_failed(ret)) {
+			logger->error("[%s] %s", function.name.c_str(), gearman_worker_error(worker.get()));
+			worker.reset();
+			return worker;
+		}
+	}
+	return worker;
+}
+
+/**
+ * @brief		I/O 쓰레드
+ * @details		처리중인 작업은 가져온 연결로 응답해야 하므로, 사용할 Job server 가 바뀌어도
+ 				처리중인 작업이 없을 때만 워커를 다시 만든다.
+ * @date		2026. 10. 16. 13:52:24
+ * @param[in]	servers	Job server 목록
+ * @param[in]	poll_interval	서버 대기 최대 시간(msec)
+ * @param[in]	index	I/O 쓰레드 번호. 연결할 서버 순서에 사용
+ * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
+ 				Otherwise, a error code is returned indicating what went wrong.
+ */
+static int
+intake_thread(JobServers *servers, const int timeout, const int poll_interval,
+			  const std::vector<JobFunction> *functions, std::shared_ptr<ComputePool> pool,
+			  WorkerDaemon *daemon, log4cpp::Category *logger, const unsigned long index) {
+	std::map<std::string, const JobFunction *> dispatch;
+	for (auto &function : *functions)
+		dispatch[function.name] = &function;
+
+	std::shared_ptr<IntakeLoop> loop;
+	try {
+		loop = std::make_shared<IntakeLoop>();
+	} catch (std::exception &e) {
+		logger->error("[intake] %s", e.what());
+		return EXIT_FAILURE;
+	}
+
+	std::shared_ptr<gearman_worker_st> worker;
+	unsigned long generation = 0;
+	Backoff backoff = daemon->getBackoff();
+	gearman_return_t ret;
+	std::size_t inflight = 0;
+	while (daemon->isRunning() || inflight) {
+		inflight -= loop->flush(logger);
+		if (loop->isBlocked()) {
+			// 보내지 못한 응답이 있으면 새 작업을 가져오지 않고 소켓이 쓰기 가능해지기를 대기
+			gearman_worker_set_timeout(worker.get(), std::min(poll_interval, 10));
+			ret = gearman_worker_wait(worker.get());
+			if (gearman_failed(ret) && ret != GEARMAN_TIMEOUT && ret != GEARMAN_IO_WAIT) {
+				logger->error("[intake] %s", gearman_worker_error(worker.get()));
+				daemon->waitForStop(backoff.next());
+			}
+			continue;
+		}
+
+		if (!daemon->isRunning()) {
+			// 처리중인 작업이 끝나기를 대기
+			loop->wait(poll_interval);
+			continue;
+		}
+		if (!inflight && (!worker || generation != servers->getGeneration())) {
+			if (worker)
+				gearman_worker_unregister_all(worker.get());
+			generation = servers->getGeneration();
+			worker = create_intake_worker(servers->getAvailable(index), timeout, functions, logger);
+			if (!worker) {
+				daemon->waitForStop(backoff.next());
+				continue;
+			}
+		}
+		if (!pool->reserve()) {
+			loop->wait(poll_interval);
+			continue;
+		}
+
+		gearman_job_st *job = gearman_worker_grab_job(worker.get(), NULL, &ret);
+		if (ret == GEARMAN_SUCCESS && job) {
+			backoff.reset();
+			auto search = dispatch.find(gearman_job_function_name(job));
+			if (search == dispatch.end()) {
+				logger->error("[intake] Unknown function: %s", gearman_job_function_name(job));
+				gearman_job_send_fail(job);
+				gearman_job_free(job);
+				pool->release();
+				continue;
+			}
+			++inflight;
+			const JobFunction *function = search->second;
+			ComputePool *compute = pool.get();
+			IntakeLoop *owner = loop.get();
+			pool->submit([compute, owner, function, job, logger] {
+				run_job(compute, owner, function, job, logger);
+			});
+			continue;
+		}
+		pool->release();	// 가져온 작업이 없음
+
+		switch (ret) {
+		case GEARMAN_IO_WAIT:
+		case GEARMAN_NO_JOBS:
+		case GEARMAN_SUCCESS:
+			// 처리중인 작업이 있으면 응답이 지연되지 않도록 짧게 대기
+			gearman_worker_set_timeout(worker.get(), inflight ? std::min(poll_interval, 10) : poll_interval);
+			ret = gearman_worker_wait(worker.get());
+			if (gearman_failed(ret) && ret != GEARMAN_TIMEOUT && ret != GEARMAN_IO_WAIT) {
+				logger->error("[intake] %s", gearman_worker_error(worker.get()));
+				servers->check(logger);
+				daemon->waitForStop(backoff.next());
+			} else {
+				servers->check(logger, false);
+			}
+			break;
+		default:
+			logger->error("[intake] %s", gearman_worker_error(worker.get()));
+			servers->check(logger);
+			daemon->waitForStop(backoff.next());
+			break;
+		}
+	}
+
+	if (worker)
+		gearman_worker_unregister_all(worker.get());
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief		event 방식 작업 수신 여부
+ * @date		2026. 10. 16. 13:58:02
+ */
+bool WorkerDaemon::isEventIntake() const {
+	return config.getConfig("master.intake", "thread") == "event";
+}
+
+/**
+ * @brief		I/O 쓰레드 및 연산 풀 실행
+ * @details		run() 으로 등록된 모든 함수를 각 I/O 쓰레드가 함께 등록한다.
+ * @date		2026. 10. 16. 14:01:36
+ * @see			join()
+ */
+void WorkerDaemon::startIntake() {
+	unsigned long io_threads = config.getConfig<unsigned long>("master.io_threads", 2UL);
+	int poll_interval = getPollInterval();
+	std::shared_ptr<ComputePool> pool = getComputePool();
+
+	logger->info("Initialize event intake (I/O: %lu, Compute: %lu)", io_threads, pool->getCapacity());
+	for (unsigned long i = 0; i < io_threads; ++i) {
+		workers.push_back(std::thread(intake_thread,
+					&servers, config.getTimeout(), poll_interval,
+					&functions, pool, this, logger, i));
+	}
+}
+
+/**
+ * @brief		연산 풀
+ * @details		event 모드의 작업과 작업의 보조 처리(submitHelper())가 master.compute_threads 개의 쓰레드를 함께 쓴다.
+ 				thread 모드에서는 처음 보조 처리를 요청할 때 만든다.
+ * @date		2026. 10. 18. 10:05:21
+ */
+std::shared_ptr<ComputePool> WorkerDaemon::getComputePool() {
+	std::call_once(compute_once, [this] {
+		unsigned long compute_threads = config.getConfig<unsigned long>("master.compute_threads",
+											static_cast<unsigned long>(std::thread::hardware_concurrency()));
+		compute_pool = std::make_shared<ComputePool>(compute_threads);
+	});
+	return compute_pool;
+}
+
+/**
+ * @brief		연산 풀의 빈 슬롯에서 작업의 보조 처리 실행
+ * @details		작업 하나를 여러 쓰레드로 나눌 때 master.compute_threads 를 넘지 않도록 연산 풀의 슬롯을 예약한다.
+ 				task 는 결과를 전송(sendData 등)하지 않아야 한다.
+ * @date		2026. 10. 18. 10:07:42
+ * @return		빈 슬롯이 없으면 false. 호출한 쓰레드가 직접 처리해야 한다
+ * @see			TaskGroup
+ */
+bool WorkerDaemon::submitHelper(std::function<void()> task) {
+	std::shared_ptr<ComputePool> pool = getComputePool();
+	if (!pool->reserve())
+		return false;
+
+	ComputePool *compute = pool.get();
+	log4cpp::Category *helper_logger = logger;
+	compute->submit([compute, helper_logger, task] {
+		try {
+			task();
+		} catch (std::exception &e) {
+			helper_logger->error("[helper] Error detected. %s", e.what());
+		}
+		compute->release();
+	});
+	return true;
+}
+
+/**
+ * @brief		보조 처리 실행
+ * @date		2026. 10. 18. 10:09:15
+ * @return		연산 풀에 빈 슬롯이 없으면 false
+ */
+bool TaskGroup::spawn(std::function<void()> task) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		++running;
+	}
+	bool submitted = daemon->submitHelper([this, task] {
+		try {
+			task();
+		} catch (...) {
+			done();
+			throw;
+		}
+		done();
+	});
+	if (!submitted)
+		done();
+	return submitted;
+}
+
+void TaskGroup::done() {
+	std::lock_guard<std::mutex> guard(lock);
+	if (--running == 0)
+		finished.notify_all();
+}
+
+/**
+ * @brief		실행한 보조 처리가 모두 끝날 때까지 대기
+ */
+void TaskGroup::wait() {
+	std::unique_lock<std::mutex> guard(lock);
+	finished.wait(guard, [this] {return running == 0;});
+}
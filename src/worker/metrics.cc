@@ -0,0 +1,264 @@
+/**
+ * @file	metrics.cc
+ * @brief	작업 처리 통계
+ * @details	각 쓰레드는 자신의 MetricsShard 에만 기록하므로 relaxed load/store 로 충분하며,
+ 			종료된 쓰레드의 shard 는 값을 유지한 채 다음 쓰레드가 넘겨받는다.
+ 			expose() 는 모든 shard 를 합산하여 Prometheus text format 으로 출력한다.
+ * @date	2026. 10. 16. 17:05:40
+ * @see		metrics.hpp
+ */
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstdio>
+
+#include "metrics.hpp"
+
+using namespace itfact::worker;
+
+namespace {
+	const char *stage_names[STAGE_MAX] = {
+		"wait", "download", "format", "decode", "resample", "vad", "setup", "frontend", "search", "result", "postproc", "send"
+	};
+	const char *counter_names[COUNTER_MAX] = {
+		"vr_jobs_total", "vr_jobs_failed_total", "vr_bytes_total", "vr_frames_total",
+		"vr_decoder_contexts_total", "vr_skipped_samples_total"
+	};
+
+	/// 단계별 처리 시간 (초)
+	const double stage_bounds[] = {
+		0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5, 10, 30, 60, 300, 1800
+	};
+	const std::size_t NR_STAGE_BUCKETS = sizeof(stage_bounds) / sizeof(stage_bounds[0]);
+
+	/// 실시간 배율 (처리 시간 / 음성 길이)
+	const double rtf_bounds[] = {
+		0.01, 0.02, 0.05, 0.1, 0.2, 0.3, 0.5, 1, 2
+	};
+	const std::size_t NR_RTF_BUCKETS = sizeof(rtf_bounds) / sizeof(rtf_bounds[0]);
+
+	struct MetricsShard {
+		std::atomic<uint64_t> stage_buckets[STAGE_MAX][NR_STAGE_BUCKETS + 1];
+		std::atomic<uint64_t> stage_count[STAGE_MAX];
+		std::atomic<uint64_t> stage_sum[STAGE_MAX];	///< nsec
+		std::atomic<uint64_t> rtf_buckets[NR_RTF_BUCKETS + 1];
+		std::atomic<uint64_t> rtf_count;
+		std::atomic<uint64_t> rtf_sum;				///< 1/1000000
+		std::atomic<uint64_t> counters[COUNTER_MAX];
+		std::atomic<uint64_t> errors[Metrics::MAX_ERROR_CODES];
+	};
+
+	std::mutex registry_lock;
+	std::vector<std::unique_ptr<MetricsShard>> shards;	///< 동시에 기록한 최대 쓰레드 수만큼만 생성
+	std::vector<MetricsShard *> idle_shards;			///< 종료된 쓰레드의 shard. 값을 유지한 채 새 쓰레드가 이어서 기록
+	std::string error_codes[Metrics::MAX_ERROR_CODES];
+	std::atomic<std::size_t> nr_error_codes(0);
+
+	/// 쓰레드가 종료되면 shard 를 재사용 목록에 돌려줌
+	struct ShardOwner {
+		MetricsShard *shard = NULL;
+
+		~ShardOwner() {
+			if (!shard)
+				return;
+			std::lock_guard<std::mutex> guard(registry_lock);
+			idle_shards.push_back(shard);
+		};
+	};
+
+	MetricsShard *local_shard() {
+		static thread_local ShardOwner owner;
+		if (!owner.shard) {
+			std::lock_guard<std::mutex> guard(registry_lock);
+			if (!idle_shards.empty()) {
+				owner.shard = idle_shards.back();
+				idle_shards.pop_back();
+			} else {
+				shards.emplace_back(new MetricsShard());
+				owner.shard = shards.back().get();
+			}
+		}
+		return owner.shard;
+	}
+
+	/// 기록하는 쓰레드가 하나뿐이므로 lock 접두어가 붙는 fetch_add 를 쓰지 않음
+	inline void bump(std::atomic<uint64_t> &value, const uint64_t amount) {
+		value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	inline std::size_t bucket(const double *bounds, const std::size_t size, const double value) {
+		std::size_t i = 0;
+		while (i < size && value > bounds[i])
+			++i;
+		return i;
+	}
+
+	void append_bucket(std::string &out, const char *name, const char *labels,
+					   const double bound, const uint64_t value) {
+		char line[256];
+		if (bound < 0)
+			std::snprintf(line, sizeof(line), "%s_bucket{%sle=\"+Inf\"} %llu\n",
+						  name, labels, (unsigned long long) value);
+		else
+			std::snprintf(line, sizeof(line), "%s_bucket{%sle=\"%g\"} %llu\n",
+						  name, labels, bound, (unsigned long long) value);
+		out.append(line);
+	}
+}
+
+void Metrics::observe(const enum METRIC_STAGE stage, const double seconds) {
+	MetricsShard *shard = local_shard();
+	bump(shard->stage_buckets[stage][bucket(stage_bounds, NR_STAGE_BUCKETS, seconds)], 1);
+	bump(shard->stage_count[stage], 1);
+	bump(shard->stage_sum[stage], static_cast<uint64_t>(seconds * 1e9));
+}
+
+void Metrics::observe(const enum METRIC_STAGE stage, const std::chrono::steady_clock::time_point &start) {
+	observe(stage, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+void Metrics::observeRTF(const double rtf) {
+	MetricsShard *shard = local_shard();
+	bump(shard->rtf_buckets[bucket(rtf_bounds, NR_RTF_BUCKETS, rtf)], 1);
+	bump(shard->rtf_count, 1);
+	bump(shard->rtf_sum, static_cast<uint64_t>(rtf * 1e6));
+}
+
+void Metrics::add(const enum METRIC_COUNTER counter, const uint64_t value) {
+	bump(local_shard()->counters[counter], value);
+}
+
+/**
+ * @brief		오류 코드별 실패 기록
+ * @details		처음 보는 코드만 잠금을 잡고 등록한다. MAX_ERROR_CODES 를 넘는 코드는 버린다.
+ * @date		2026. 10. 16. 17:14:22
+ * @param[in]	code	오류 코드 (E10200 등)
+ */
+void Metrics::fail(const std::string &code) {
+	std::size_t count = nr_error_codes.load(std::memory_order_acquire);
+	std::size_t index = 0;
+	while (index < count && error_codes[index] != code)
+		++index;
+
+	if (index == count) {
+		std::lock_guard<std::mutex> guard(registry_lock);
+		count = nr_error_codes.load(std::memory_order_relaxed);
+		while (index < count && error_codes[index] != code)
+			++index;
+		if (index == count) {
+			if (count >= MAX_ERROR_CODES)
+				return;
+			error_codes[count] = code;
+			nr_error_codes.store(count + 1, std::memory_order_release);
+		}
+	}
+	bump(local_shard()->errors[index], 1);
+}
+
+/**
+ * @brief		Prometheus text format 출력
+ * @date		2026. 10. 16. 17:18:50
+ * @return		통계
+ */
+std::string Metrics::expose() {
+	uint64_t stage_buckets[STAGE_MAX][NR_STAGE_BUCKETS + 1] = {{0}};
+	uint64_t stage_count[STAGE_MAX] = {0};
+	uint64_t stage_sum[STAGE_MAX] = {0};
+	uint64_t rtf_buckets[NR_RTF_BUCKETS + 1] = {0};
+	uint64_t rtf_count = 0, rtf_sum = 0;
+	uint64_t counters[COUNTER_MAX] = {0};
+	uint64_t errors[MAX_ERROR_CODES] = {0};
+	std::size_t nr_codes = nr_error_codes.load(std::memory_order_acquire);
+
+	{
+		std::lock_guard<std::mutex> guard(registry_lock);
+		for (auto &shard : shards) {
+			for (std::size_t s = 0; s < STAGE_MAX; ++s) {
+				for (std::size_t b = 0; b <= NR_STAGE_BUCKETS; ++b)
+					stage_buckets[s][b] += shard->stage_buckets[s][b].load(std::memory_order_relaxed);
+				stage_count[s] += shard->stage_count[s].load(std::memory_order_relaxed);
+				stage_sum[s] += shard->stage_sum[s].load(std::memory_order_relaxed);
+			}
+			for (std::size_t b = 0; b <= NR_RTF_BUCKETS; ++b)
+				rtf_buckets[b] += shard->rtf_buckets[b].load(std::memory_order_relaxed);
+			rtf_count += shard->rtf_count.load(std::memory_order_relaxed);
+			rtf_sum += shard->rtf_sum.load(std::memory_order_relaxed);
+			for (std::size_t c = 0; c < COUNTER_MAX; ++c)
+				counters[c] += shard->counters[c].load(std::memory_order_relaxed);
+			for (std::size_t e = 0; e < nr_codes; ++e)
+				errors[e] += shard->errors[e].load(std::memory_order_relaxed);
+		}
+	}
+
+	std::string out;
+	char line[256];
+
+	out.append("# HELP vr_stage_seconds Time spent in each job stage.\n");
+	out.append("# TYPE vr_stage_seconds histogram\n");
+	for (std::size_t s = 0; s < STAGE_MAX; ++s) {
+		std::string labels("stage=\"");
+		labels.append(stage_names[s]);
+		labels.append("\",");
+
+		uint64_t cumulative = 0;
+		for (std::size_t b = 0; b < NR_STAGE_BUCKETS; ++b) {
+			cumulative += stage_buckets[s][b];
+			append_bucket(out, "vr_stage_seconds", labels.c_str(), stage_bounds[b], cumulative);
+		}
+		append_bucket(out, "vr_stage_seconds", labels.c_str(), -1, cumulative + stage_buckets[s][NR_STAGE_BUCKETS]);
+		std::snprintf(line, sizeof(line), "vr_stage_seconds_sum{stage=\"%s\"} %.9g\n",
+					  stage_names[s], stage_sum[s] / 1e9);
+		out.append(line);
+		std::snprintf(line, sizeof(line), "vr_stage_seconds_count{stage=\"%s\"} %llu\n",
+					  stage_names[s], (unsigned long long) stage_count[s]);
+		out.append(line);
+	}
+
+	out.append("# HELP vr_realtime_factor Processing time divided by audio duration per job.\n");
+	out.append("# TYPE vr_realtime_factor histogram\n");
+	uint64_t cumulative = 0;
+	for (std::size_t b = 0; b < NR_RTF_BUCKETS; ++b) {
+		cumulative += rtf_buckets[b];
+		append_bucket(out, "vr_realtime_factor", "", rtf_bounds[b], cumulative);
+	}
+	append_bucket(out, "vr_realtime_factor", "", -1, cumulative + rtf_buckets[NR_RTF_BUCKETS]);
+	std::snprintf(line, sizeof(line), "vr_realtime_factor_sum %.9g\nvr_realtime_factor_count %llu\n",
+				  rtf_sum / 1e6, (unsigned long long) rtf_count);
+	out.append(line);
+
+	for (std::size_t c = 0; c < COUNTER_MAX; ++c) {
+		std::snprintf(line, sizeof(line), "# TYPE %s counter\n%s %llu\n",
+					  counter_names[c], counter_names[c], (unsigned long long) counters[c]);
+		out.append(line);
+	}
+
+	out.append("# HELP vr_errors_total Failures by error code.\n");
+	out.append("# TYPE vr_errors_total counter\n");
+	for (std::size_t e = 0; e < nr_codes; ++e) {
+		std::snprintf(line, sizeof(line), "vr_errors_total{code=\"%s\"} %llu\n",
+					  error_codes[e].c_str(), (unsigned long long) errors[e]);
+		out.append(line);
+	}
+
+	return out;
+}
+
+/**
+ * @brief		단계별 누적 처리 시간
+ * @details		모든 쓰레드의 합이므로 여러 쓰레드가 동시에 처리하면 경과 시간보다 클 수 있다.
+ * @date		2026. 10. 17. 19:48:05
+ * @param[in]	stage	작업 처리 단계
+ * @return		초
+ */
+double Metrics::stageSeconds(const enum METRIC_STAGE stage) {
+	uint64_t sum = 0;
+	std::lock_guard<std::mutex> guard(registry_lock);
+	for (auto &shard : shards)
+		sum += shard->stage_sum[stage].load(std::memory_order_relaxed);
+	return sum / 1e9;
+}
+
+const char *Metrics::stageName(const enum METRIC_STAGE stage) {
+	return stage_names[stage];
+}
@@ -0,0 +1,152 @@
+/**
+ * @file	rebalance.cc
+ * @brief	Worker slot rebalancing
+ * @details	gearman 관리 프로토콜의 status 명령으로 함수별 대기/처리중인 작업 수를 조회하여
+ 			전체 슬롯 수(rebalance.budget) 안에서 함수별 등록 슬롯 수를 조정한다.
+ * @date	2026. 10. 16. 16:20:05
+ * @see		worker.cc
+ */
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "worker.hpp"
+
+using namespace itfact::worker;
+
+/**
+ * @brief		함수별 작업 수 조회
+ * @details		status 응답은 "FUNCTION\tTOTAL\tRUNNING\tAVAILABLE_WORKERS" 형식이며 "." 으로 끝난다.
+ 				TOTAL 은 대기중인 작업과 처리중인 작업을 합한 값이다.
+ * @date		2026. 10. 16. 16:24:51
+ * @param[in]	server	Job server
+ * @param[out]	jobs	함수별 작업 수. 기존 값에 누적
+ * @retval		true	조회 성공
+ * @retval		false	조회 실패
+ */
+static bool
+query_status(const JobServer &server, std::map<std::string, unsigned long> &jobs,
+			 log4cpp::Category *logger) {
+	const std::string &host = server.host;
+	const int port = server.port;
+	int sock = JobServers::connect(server, 3000);
+	if (sock < 0) {
+		logger->warn("[rebalance] Cannot connect to %s:%d", host.c_str(), port);
+		return false;
+	}
+	std::shared_ptr<int> guard(&sock, [](int *fd) {close(*fd);});
+
+	const char command[] = "status\n";
+	if (send(sock, command, sizeof(command) - 1, MSG_NOSIGNAL) != sizeof(command) - 1) {
+		logger->warn("[rebalance] %s:%d: %s", host.c_str(), port, std::strerror(errno));
+		return false;
+	}
+
+	std::string response;
+	char buffer[4096];
+	while (response.compare(0, 2, ".\n") != 0 &&
+		   (response.size() < 3 || response.compare(response.size() - 3, 3, "\n.\n") != 0)) {
+		ssize_t bytes = recv(sock, buffer, sizeof(buffer), 0);
+		if (bytes <= 0) {
+			logger->warn("[rebalance] %s:%d: %s", host.c_str(), port,
+						 bytes ? std::strerror(errno) : "Connection closed");
+			return false;
+		}
+		response.append(buffer, bytes);
+	}
+
+	std::istringstream lines(response);
+	std::string line;
+	while (std::getline(lines, line) && line.compare(".") != 0) {
+		std::istringstream fields(line);
+		std::string name;
+		unsigned long total = 0;
+		if (std::getline(fields, name, '\t') && (fields >> total))
+			jobs[name] += total;
+	}
+	return true;
+}
+
+/**
+ * @brief		슬롯 재분배 사용 여부
+ * @details		event 모드에서는 모든 함수가 연산 풀을 공유하므로 사용하지 않는다.
+ * @date		2026. 10. 16. 16:31:12
+ */
+bool WorkerDaemon::isRebalancing() const {
+	return !isEventIntake() && config.getConfig<bool>("rebalance.enable", false);
+}
+
+/**
+ * @brief		슬롯 재분배 쓰레드
+ * @details		각 함수에 최소 슬롯을 배정한 뒤, 남은 슬롯을 작업 수 대비 슬롯이 가장 부족한 함수부터
+ 				하나씩 배정한다. 작업 수보다 많은 슬롯은 배정하지 않으며, 그래도 남는 슬롯은
+ 				현재 등록된 수를 넘지 않는 범위에서 유지하여 불필요한 등록 변경을 줄인다.
+ * @date		2026. 10. 16. 16:35:48
+ */
+void WorkerDaemon::rebalance() {
+	unsigned long total_slots = 0;
+	for (auto &function : slots)
+		total_slots += function->target;
+	const unsigned long budget = config.getConfig<unsigned long>("rebalance.budget", total_slots);
+	const long interval = config.getConfig<long>("rebalance.interval", 10L * 1000);
+	logger->info("Rebalance %lu slot(s) every %ld ms", budget, interval);
+
+	while (!waitForStop(interval)) {
+		// 모든 Job server 의 작업 수를 합산
+		std::map<std::string, unsigned long> jobs;
+		bool queried = false;
+		for (auto &server : servers.getAll())
+			queried |= query_status(server, jobs, logger);
+		if (!queried)
+			continue;
+
+		const std::size_t count = slots.size();
+		std::vector<unsigned long> demand(count), desired(count), current(count);
+		unsigned long assigned = 0;
+		for (std::size_t i = 0; i < count; ++i) {
+			auto search = jobs.find(slots[i]->name);
+			demand[i] = (search != jobs.end()) ? search->second : 0;
+			current[i] = slots[i]->target;
+			desired[i] = slots[i]->min;
+			assigned += desired[i];
+		}
+
+		// 작업 수에 비례하여 배정
+		while (assigned < budget) {
+			std::size_t best = count;
+			double best_score = 0.0;
+			for (std::size_t i = 0; i < count; ++i) {
+				if (desired[i] >= std::min(slots[i]->max, demand[i]))
+					continue;
+				double score = static_cast<double>(demand[i]) / (desired[i] + 1);
+				if (score > best_score) {
+					best = i;
+					best_score = score;
+				}
+			}
+			if (best == count)
+				break;
+			++desired[best];
+			++assigned;
+		}
+
+		// 남은 슬롯은 기존 배정 유지
+		for (std::size_t i = 0; i < count && assigned < budget; ++i) {
+			unsigned long keep = std::min(std::max(desired[i], std::min(current[i], slots[i]->max)),
+										  desired[i] + (budget - assigned));
+			assigned += keep - desired[i];
+			desired[i] = keep;
+		}
+
+		for (std::size_t i = 0; i < count; ++i) {
+			if (desired[i] == current[i])
+				continue;
+			logger->info("Rebalance %s: %lu -> %lu slot(s) (jobs: %lu)",
+						 slots[i]->name.c_str(), current[i], desired[i], demand[i]);
+			slots[i]->target = desired[i];
+		}
+	}
+}
@@ -0,0 +1,210 @@
+/**
+ * @file	servers.cc
+ * @brief	Job server 목록 및 재연결 백오프
+ * @details	master.host 에 "host:port,host:port" 형식으로 여러 Job server 를 지정할 수 있다.
+ 			워커는 응답하는 모든 서버에 연결하며, 쓰레드마다 서버 순서를 돌려 첫 연결이 한 서버에
+ 			몰리지 않도록 한다.
+ * @date	2026. 10. 17. 09:12:30
+ * @see		worker.cc
+ */
+#include <algorithm>
+#include <sstream>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include "worker.hpp"
+
+using namespace itfact::worker;
+
+/**
+ * @brief		Job server 목록 설정
+ * @date		2026. 10. 17. 09:14:02
+ * @param[in]	hosts			"host[:port][,host[:port]...]"
+ * @param[in]	default_port	Port 가 없는 항목에 사용할 port
+ * @param[in]	interval		장애 서버 재확인 주기 (msec)
+ * @param[in]	logger			Port 가 잘못된 항목은 기록하고 건너뜀
+ */
+void JobServers::configure(const std::string &hosts, const in_port_t default_port, const long interval,
+						   log4cpp::Category *logger) {
+	std::lock_guard<std::mutex> guard(lock);
+	servers.clear();
+
+	std::istringstream list(hosts);
+	std::string item;
+	while (std::getline(list, item, ',')) {
+		item.erase(0, item.find_first_not_of(" \t"));
+		item.erase(item.find_last_not_of(" \t") + 1);
+		if (item.empty())
+			continue;
+
+		JobServer server = {item, default_port};
+		std::size_t colon = item.rfind(':');
+		if (colon != std::string::npos && item.find(':') == colon) {
+			const char *port = item.c_str() + colon + 1;
+			char *port_end;
+			errno = 0;
+			unsigned long value = std::strtoul(port, &port_end, 10);
+			if (port_end == port || *port_end || errno || !value || value > 65535 || port[0] == '-' ||
+				colon == 0) {
+				logger->error("Invalid job server: %s", item.c_str());
+				continue;
+			}
+			server.host = item.substr(0, colon);
+			server.port = static_cast<in_port_t>(value);
+		}
+		servers.push_back(server);
+	}
+
+	alive.assign(servers.size(), true);
+	recheck_interval = interval;
+	last_check = std::chrono::steady_clock::now();
+	++generation;
+}
+
+/**
+ * @brief		연결할 Job server 목록
+ * @details		응답하는 서버가 없으면 전체 목록을 반환하여 libgearman 이 직접 재시도하도록 한다.
+ * @date		2026. 10. 17. 09:18:45
+ * @param[in]	rotate	목록을 회전할 위치 (쓰레드 번호)
+ */
+std::vector<JobServer> JobServers::getAvailable(const std::size_t rotate) const {
+	std::vector<JobServer> available;
+	std::lock_guard<std::mutex> guard(lock);
+	for (std::size_t i = 0; i < servers.size(); ++i) {
+		if (alive[i])
+			available.push_back(servers[i]);
+	}
+	if (available.empty())
+		available = servers;
+	if (!available.empty())
+		std::rotate(available.begin(), available.begin() + (rotate % available.size()), available.end());
+	return available;
+}
+
+std::vector<JobServer> JobServers::getAll() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return servers;
+}
+
+/**
+ * @brief		Job server 상태 확인
+ * @details		여러 쓰레드가 동시에 오류를 만나도 1초에 한 번만 확인한다.
+ 				force 가 false 이면 장애 서버가 있고 재확인 주기가 지났을 때만 확인한다.
+ 				사용할 서버가 바뀌면 generation 을 증가시킨다.
+ * @date		2026. 10. 17. 09:23:10
+ * @param[in]	force	오류로 인한 확인
+ */
+void JobServers::check(log4cpp::Category *logger, const bool force) {
+	std::vector<JobServer> targets;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto now = std::chrono::steady_clock::now();
+		auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_check).count();
+		if (elapsed < 1000)
+			return;
+		if (!force && (elapsed < recheck_interval ||
+					   std::find(alive.begin(), alive.end(), false) == alive.end()))
+			return;
+		last_check = now;
+		targets = servers;
+	}
+
+	std::vector<bool> result(targets.size());
+	for (std::size_t i = 0; i < targets.size(); ++i) {
+		int sock = connect(targets[i], 1000);
+		result[i] = (sock >= 0);
+		if (sock >= 0)
+			close(sock);
+	}
+
+	std::lock_guard<std::mutex> guard(lock);
+	if (result.size() != alive.size() || result == alive)
+		return;
+	for (std::size_t i = 0; i < targets.size(); ++i) {
+		if (result[i] != alive[i])
+			logger->warn("Job server %s:%d is %s", targets[i].host.c_str(), targets[i].port,
+						 result[i] ? "back" : "down");
+	}
+	alive = result;
+	++generation;
+}
+
+/**
+ * @brief		Job server TCP 연결
+ * @date		2026. 10. 17. 09:27:36
+ * @param[in]	server	Job server
+ * @param[in]	timeout	연결 및 송수신 제한 시간 (msec)
+ * @return		Upon successful completion, a socket is returned.\n
+ 				Otherwise, -1 is returned.
+ */
+int JobServers::connect(const JobServer &server, const long timeout) {
+	struct addrinfo hints, *result = NULL;
+	std::memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	if (getaddrinfo(server.host.c_str(), std::to_string(server.port).c_str(), &hints, &result))
+		return -1;
+	std::shared_ptr<struct addrinfo> addresses(result, freeaddrinfo);
+
+	struct timeval tv = {timeout / 1000, (timeout % 1000) * 1000};
+	for (struct addrinfo *ai = addresses.get(); ai; ai = ai->ai_next) {
+		int sock = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK, ai->ai_protocol);
+		if (sock < 0)
+			continue;
+
+		int rc = ::connect(sock, ai->ai_addr, ai->ai_addrlen);
+		if (rc && errno == EINPROGRESS) {
+			struct pollfd pfd = {sock, POLLOUT, 0};
+			int error = ETIMEDOUT;
+			socklen_t length = sizeof(error);
+			if (poll(&pfd, 1, static_cast<int>(timeout)) == 1)
+				getsockopt(sock, SOL_SOCKET, SO_ERROR, &error, &length);
+			rc = error ? -1 : 0;
+		}
+		if (rc == 0) {
+			fcntl(sock, F_SETFL, fcntl(sock, F_GETFL) & ~O_NONBLOCK);
+			setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+			setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+			return sock;
+		}
+		close(sock);
+	}
+	return -1;
+}
+
+Backoff::Backoff(const long base_msec, const long max_msec)
+	: base(std::max(1L, base_msec)), max(std::max(base_msec, max_msec)), random(std::random_device()()) {
+}
+
+/**
+ * @brief		다음 대기 시간
+ * @details		대기 시간은 min(max, base * 2^attempt) 의 절반에서 전체 사이의 임의 값이다.
+ 				여러 쓰레드가 같은 서버 장애를 만나도 재연결 시점이 흩어진다.
+ * @date		2026. 10. 17. 09:31:54
+ * @return		대기 시간 (msec)
+ */
+long Backoff::next() {
+	long ceiling = max;
+	if (attempt < 30 && (base << attempt) < max)
+		ceiling = base << attempt;
+	if (ceiling < max)
+		++attempt;
+	std::uniform_int_distribution<long> jitter(ceiling / 2, ceiling);
+	return jitter(random);
+}
+
+/**
+ * @brief		재연결 백오프 생성
+ * @date		2026. 10. 17. 09:33:20
+ */
+Backoff WorkerDaemon::getBackoff() const {
+	return Backoff(config.getConfig<long>("master.retry_base", 100L),
+				   config.getConfig<long>("master.retry_max", 10L * 1000));
+}
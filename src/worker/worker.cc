@@ -9,6 +9,13 @@
 #include <cerrno>
 #include <cstring>
 #include <mutex>
+#include <algorithm>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
 
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -17,7 +24,24 @@
 
 using namespace itfact::worker;
 
-static std::mutex curl_lock;
+/**
+ * @brief		CURL 전역 초기화 및 해제 
+ * @details		curl_global_cleanup() 은 CurlPool 의 공유 객체와 주 쓰레드의 핸들이 모두 해제된 뒤에
+ 				호출해야 하므로, 그보다 먼저 생성되는 정적 객체의 소멸자에서 호출한다.
+ * @date		2026. 10. 17. 22:10:31
+ */
+class CurlGlobal : private boost::noncopyable
+{
+public:
+	CurlGlobal() {
+		CURLcode rc = curl_global_init(CURL_GLOBAL_ALL);
+		if (rc) {
+			std::perror(curl_easy_strerror(rc));
+			throw std::runtime_error(curl_easy_strerror(rc));
+		}
+	};
+	~CurlGlobal() {curl_global_cleanup();};
+};
 
 /**
  * @brief		CURL 초기화 
@@ -25,11 +49,86 @@ static std::mutex curl_lock;
  * @date		2016. 07. 14. 09:38:57
  */
 static inline void init_curl() {
-	CURLcode rc = curl_global_init(CURL_GLOBAL_ALL);
-	if (rc) {
-		std::perror(curl_easy_strerror(rc));
-		throw std::runtime_error(curl_easy_strerror(rc));
+	static CurlGlobal global;
+}
+
+/**
+ * @brief		CURL 공유 객체 
+ * @details		DNS, TLS 세션, 커넥션 캐시를 쓰레드간에 공유하며, 데이터 종류별로 잠금을 분리한다.
+ * @date		2026. 10. 16. 11:02:47
+ */
+class CurlShare : private boost::noncopyable
+{
+private: // Member
+	CURLSH *share;
+	std::mutex locks[CURL_LOCK_DATA_LAST];
+
+public:
+	CurlShare() {
+		share = curl_share_init();
+		if (!share)
+			throw std::runtime_error("Cannot allocation CURLSH");
+		curl_share_setopt(share, CURLSHOPT_LOCKFUNC, CurlShare::lock);
+		curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, CurlShare::unlock);
+		curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+		curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+		curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900	// 7.57.0
+		curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+	};
+	~CurlShare() {curl_share_cleanup(share);};
+	CURLSH *get() {return share;};
+
+private:
+	static void lock(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr) {
+		((CurlShare *) userptr)->locks[data].lock();
+	};
+	static void unlock(CURL *handle, curl_lock_data data, void *userptr) {
+		((CurlShare *) userptr)->locks[data].unlock();
+	};
+};
+
+/**
+ * @brief		쓰레드가 소유하는 CURL 핸들 
+ * @details		공유 객체보다 먼저 해제되도록 공유 객체의 참조를 함께 보관한다.
+ * @date		2026. 10. 16. 11:05:13
+ */
+struct CurlHandle {
+	std::shared_ptr<CurlShare> share;
+	CURL *curl = NULL;
+
+	~CurlHandle() {
+		if (curl)
+			curl_easy_cleanup(curl);
+	};
+};
+
+/**
+ * @brief		현재 쓰레드의 CURL 핸들 반환 
+ * @details		재사용되는 핸들은 curl_easy_reset()으로 옵션만 초기화하므로
+ 				열려있는 커넥션과 세션 캐시는 유지된다.
+ * @date		2026. 10. 16. 11:07:38
+ * @return		CURL 핸들 
+ * @retval		NULL	핸들 할당 실패 
+ */
+CURL *CurlPool::getHandle() {
+	init_curl();
+	static std::shared_ptr<CurlShare> share = std::make_shared<CurlShare>();
+	static thread_local CurlHandle handle;
+
+	if (!handle.curl) {
+		handle.curl = curl_easy_init();
+		if (!handle.curl)
+			return NULL;
+		handle.share = share;
+	} else {
+		curl_easy_reset(handle.curl);
 	}
+
+	curl_easy_setopt(handle.curl, CURLOPT_SHARE, handle.share->get());
+	curl_easy_setopt(handle.curl, CURLOPT_NOSIGNAL, 1L);
+	return handle.curl;
 }
 
 WorkerDaemon::WorkerDaemon() {
@@ -42,7 +141,6 @@ WorkerDaemon::WorkerDaemon(const int argc, const char *argv[]) : config(argc, ar
 }
 
 WorkerDaemon::~WorkerDaemon() {
-	curl_global_cleanup();
 }
 
 /**
@@ -64,56 +162,150 @@ int WorkerDaemon::initialize(const int argc, const char *argv[]) {
 }
 
 /**
- * @brief		워커를 실행시키기 위한 쓰래드 함수 
- * @author		Kijeong Khil (kjkhil@itfact.co.kr)
- * @date		2016. 06. 07. 10:59:39
- * @param[in]	host	Connect to the host
- * @param[in]	port	Port number use for connection
- * @param[in]	timeout	Timeout in milliseconds
- * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
- 				Otherwise, a error code is returned indicating what went wrong.
+ * @brief		작업 실행 
+ * @details		처리중인 작업 수를 관리하며, 모든 워커 함수는 이 함수를 통해 호출된다.\n
+ 				같은 쓰레드의 이전 작업이 끝난 후부터 이번 작업을 받기까지를 대기 시간으로 기록한다.
+ * @date		2026. 10. 16. 15:04:12
+ * @param[in]	job			작업 
+ * @param[in]	function	JobFunction
  */
-static int
-worker_thread(const std::string name, const char *host, const int port, const int timeout,
-			  WorkerDaemon *daemon, log4cpp::Category *logger, void *context,
-			  gearman_return_t (*fn)(gearman_job_st *, void *)) {
-	gearman_worker_st worker_st;
-	if (gearman_worker_create(&worker_st) == NULL) {
+gearman_return_t WorkerDaemon::execute(gearman_job_st *job, void *function) {
+	static thread_local std::chrono::steady_clock::time_point last_finished;
+	static thread_local bool has_finished = false;
+	const JobFunction *binding = (const JobFunction *) function;
+	struct ActiveJob {
+		std::atomic<unsigned long> &count;
+		ActiveJob(std::atomic<unsigned long> &counter) : count(counter) {++count;};
+		~ActiveJob() {
+			--count;
+			last_finished = std::chrono::steady_clock::now();
+			has_finished = true;
+		};
+	} active(binding->daemon->active_jobs);
+
+	if (has_finished)
+		Metrics::observe(STAGE_WAIT, last_finished);
+	Metrics::add(COUNTER_JOBS);
+
+	gearman_return_t ret = binding->fn(job, binding->context);
+	if (gearman_failed(ret))
+		Metrics::add(COUNTER_FAILED);
+	return ret;
+}
+
+/**
+ * @brief		워커 생성 및 함수 등록 
+ * @details		응답하는 모든 Job server 에 연결한다.
+ * @date		2026. 10. 16. 16:02:18
+ * @return		생성된 워커. 실패 시 NULL
+ */
+static std::shared_ptr<gearman_worker_st>
+create_worker(const std::string &name, const std::vector<JobServer> &servers, const int timeout,
+			  const int poll_interval, JobFunction *function, log4cpp::Category *logger) {
+	std::shared_ptr<gearman_worker_st> worker;
+	gearman_worker_st *worker_st = gearman_worker_create(NULL);
+	if (worker_st == NULL) {
 		logger->fatal("[%s] Memory allocation failure on worker creation", name.c_str());
-		return EXIT_FAILURE;
+		return worker;
 	}
-	std::shared_ptr<gearman_worker_st> worker(&worker_st, gearman_worker_free);
-
-	gearman_return_t ret = gearman_worker_add_server(worker.get(), host, port);
-	if (ret != GEARMAN_SUCCESS) {
-		logger->error("[%s] %s", name.c_str(), gearman_worker_error(worker.get()));
-		return EXIT_FAILURE;
+	worker.reset(worker_st, gearman_worker_free);
+
+	for (auto &server : servers) {
+		gearman_return_t ret = gearman_worker_add_server(worker.get(), server.host.c_str(), server.port);
+		if (ret != GEARMAN_SUCCESS) {
+			logger->error("[%s] %s", name.c_str(), gearman_worker_error(worker.get()));
+			worker.reset();
+			return worker;
+		}
 	}
 
-	ret = gearman_worker_define_function(worker.get(),
+	gearman_return_t ret = gearman_worker_define_function(worker.get(),
 										 name.c_str(), name.size(),
-										 gearman_function_create(fn),
+										 gearman_function_create(WorkerDaemon::execute),
 										 timeout,
-										 context);
+										 function);
 	if (gearman_failed(ret)) {
 		std::cout << gearman_worker_error(worker.get()) << std::endl;
 		logger->error("[%s] %s", name.c_str(), gearman_worker_error(worker.get()));
-		return EXIT_FAILURE;
+		worker.reset();
+		return worker;
 	}
 
+	gearman_worker_set_timeout(worker.get(), poll_interval);
+	return worker;
+}
+
+/**
+ * @brief		워커를 실행시키기 위한 쓰래드 함수 
+ * @details		서버 대기는 poll_interval 마다 깨어나 종료 여부를 확인하며,
+ 				종료 시 처리중인 작업을 마친 후 함수 등록을 해제한다.\n
+ 				slots 가 지정되면 작업 사이마다 자신의 슬롯 번호를 확인하여 등록 여부를 바꾼다.\n
+ 				오류 시 Job server 상태를 확인하고 백오프 후 재시도하며, 사용할 서버가 바뀌면
+ 				작업 사이에 워커를 다시 만든다.
+ * @author		Kijeong Khil (kjkhil@itfact.co.kr)
+ * @date		2016. 06. 07. 10:59:39
+ * @param[in]	servers	Job server 목록
+ * @param[in]	timeout	Timeout in milliseconds
+ * @param[in]	poll_interval	서버 대기 최대 시간(msec)
+ * @param[in]	slots	재분배 대상 슬롯. 고정 워커는 NULL
+ * @param[in]	index	슬롯 번호. 연결할 서버 순서에도 사용
+ * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
+ 				Otherwise, a error code is returned indicating what went wrong.
+ */
+static int
+worker_thread(const std::string name, JobServers *servers, const int timeout,
+			  const int poll_interval, WorkerDaemon *daemon, log4cpp::Category *logger,
+			  JobFunction function, std::shared_ptr<WorkerSlots> slots, const unsigned long index) {
+	std::shared_ptr<gearman_worker_st> worker;
+	unsigned long generation = 0;
+	Backoff backoff = daemon->getBackoff();
+
+	gearman_return_t ret;
 	while (daemon->isRunning()) {
+		// 서버와의 연결을 끊어야 해당 워커로 작업이 배정되지 않음
+		if (slots && index >= slots->target) {
+			if (worker) {
+				gearman_worker_unregister_all(worker.get());
+				worker.reset();
+			}
+			daemon->waitForStop(poll_interval);
+			continue;
+		}
+		if (worker && generation != servers->getGeneration()) {
+			gearman_worker_unregister_all(worker.get());
+			worker.reset();
+		}
+		if (!worker) {
+			generation = servers->getGeneration();
+			worker = create_worker(name, servers->getAvailable(index), timeout, poll_interval, &function, logger);
+			if (!worker) {
+				daemon->waitForStop(backoff.next());
+				continue;
+			}
+		}
+
 		try {
 			ret = gearman_worker_work(worker.get());
+			if (ret == GEARMAN_TIMEOUT) {
+				servers->check(logger, false);
+				backoff.reset();
+				continue;
+			}
 			if (gearman_failed(ret)) {
 				logger->error("[%s] %s", name.c_str(), gearman_worker_error(worker.get()));
-				std::this_thread::sleep_for(std::chrono::seconds(10));
+				servers->check(logger);
+				daemon->waitForStop(backoff.next());
+			} else {
+				backoff.reset();
 			}
 		} catch (std::exception &e) {
 			logger->error("[%s] Error detected. %s", name.c_str(), e.what());
-			std::this_thread::sleep_for(std::chrono::seconds(10));
+			daemon->waitForStop(backoff.next());
 		}
 	}
 
+	if (worker)
+		gearman_worker_unregister_all(worker.get());
 	return EXIT_SUCCESS;
 }
 
@@ -147,20 +339,49 @@ void WorkerDaemon::run(const std::string name, void *context, unsigned int count
 	logger->info("Initialize %s", name.c_str());
 	//logger->info("Initialize count %d", count);
 	is_running = true;
+	if (!count)
+		return;
+	if (servers.empty())
+		servers.configure(config.getHost(), getPort(), config.getConfig<long>("master.retry_max", 10L * 1000),
+						  logger);
+	JobFunction function = {name, context, fn, this};
+	if (isEventIntake() && name.compare("vr_realtime")) {
+		// 실시간 채널은 순서 보장을 위해 전용 쓰레드 유지
+		functions.push_back(function);
+		return;
+	}
+
 	if ( !name.compare("vr_realtime")) {
 		unsigned int sNum = config.getConfig("realtime.startnum", 0);
 		for (unsigned int i = sNum; i < count+sNum; ++i) {
 			std::string sNewFname = name + "_" + std::to_string(i);
 			workers.push_back(std::thread(worker_thread, sNewFname,
-					config.getHost().c_str(), config.getPort(), config.getTimeout(),
-					this, logger, context, fn));
+					&servers, config.getTimeout(),
+					getPollInterval(), this, logger, function, nullptr, i - sNum));
+		}
+	}
+	else if (isRebalancing()) {
+		// 최대 슬롯만큼 쓰레드를 만들고 count 개만 등록 
+		unsigned long lower = config.getConfig<unsigned long>("rebalance." + name + "_min", 1UL);
+		unsigned long upper = config.getConfig<unsigned long>("rebalance." + name + "_max",
+										config.getConfig<unsigned long>("rebalance.budget", count * 2UL));
+		if (upper < lower)
+			upper = lower;
+		std::shared_ptr<WorkerSlots> function_slots = std::make_shared<WorkerSlots>(
+			name, std::min(std::max(static_cast<unsigned long>(count), lower), upper), lower, upper);
+		slots.push_back(function_slots);
+
+		for (unsigned long i = 0; i < upper; ++i) {
+			workers.push_back(std::thread(worker_thread, name,
+						&servers, config.getTimeout(),
+						getPollInterval(), this, logger, function, function_slots, i));
 		}
 	}
 	else {
 		for (unsigned int i = 0; i < count; ++i) {
 			workers.push_back(std::thread(worker_thread, name,
-						config.getHost().c_str(), config.getPort(), config.getTimeout(),
-						this, logger, context, fn));
+						&servers, config.getTimeout(),
+						getPollInterval(), this, logger, function, nullptr, i));
 		}
 	}
 }
@@ -172,46 +393,259 @@ void WorkerDaemon::run(const std::string name, void *context, unsigned int count
  */
 void WorkerDaemon::join() {
 	if (is_running) {
+		if (!functions.empty())
+			startIntake();
+		if (!slots.empty())
+			controller = std::thread(&WorkerDaemon::rebalance, this);
 		for (std::vector<std::thread>::iterator iter = workers.begin(); iter != workers.end(); ++iter)
 			(*iter).join();
 	}
+	compute_pool.reset();
+	if (controller.joinable())
+		controller.join();
+
+	{
+		std::lock_guard<std::mutex> guard(state_lock);
+		drained = true;
+	}
+	state_cv.notify_all();
+	if (drain_watchdog.joinable()) {
+		drain_watchdog.join();
+		logger->info("Drain completed");
+	}
 }
 
 /**
  * @brief		워커 종료 
+ * @details		새 작업은 더 이상 가져오지 않고 처리중인 작업이 끝나기를 기다린다.
+ 				master.drain_timeout 안에 끝나지 않으면 남은 작업을 버리고 프로세스를 종료한다.
  * @author		Kijeong Khil (kjkhil@itfact.co.kr)
  * @date		2016. 06. 23. 13:03:41
  * @see			run()
  */
 void WorkerDaemon::stop() {
-	is_running = false;
+	std::lock_guard<std::mutex> guard(state_lock);
+	if (!is_running.exchange(false) || drained || drain_watchdog.joinable())
+		return;
+
+	long drain_timeout = config.getConfig<long>("master.drain_timeout", 10L * 60 * 1000);
+	logger->info("Drain started: %lu job(s) in progress, timeout %ld ms", getActiveJobs(), drain_timeout);
+	state_cv.notify_all();
+
+	drain_watchdog = std::thread([this, drain_timeout] {
+		std::unique_lock<std::mutex> lock(state_lock);
+		if (!state_cv.wait_for(lock, std::chrono::milliseconds(drain_timeout), [this] {return drained;})) {
+			logger->error("Drain timeout: abandon %lu job(s)", getActiveJobs());
+			_exit(EXIT_FAILURE);
+		}
+	});
+}
 
-	/// todo 응답을 대기하고 있는 워커 강제 종료 
+/**
+ * @brief		종료 요청 대기 
+ * @date		2026. 10. 16. 15:12:40
+ * @param[in]	msec	최대 대기 시간 
+ * @retval		true	종료 요청됨 
+ * @retval		false	시간 초과 
+ */
+bool WorkerDaemon::waitForStop(const long msec) {
+	std::unique_lock<std::mutex> lock(state_lock);
+	return state_cv.wait_for(lock, std::chrono::milliseconds(msec), [this] {return !is_running;});
+}
+
+/**
+ * @brief		종료 시그널 처리 
+ * @details		SIGTERM, SIGINT, SIGHUP 을 전용 쓰레드에서 받아 stop() 을 호출한다.
+ 				이후 생성되는 쓰레드가 시그널 마스크를 상속하도록 다른 쓰레드를 만들기 전에 호출해야 하며,
+ 				종료 대기 중 다시 시그널을 받으면 즉시 종료한다.
+ * @date		2026. 10. 16. 15:16:27
+ */
+void WorkerDaemon::catchSignals() {
+	sigset_t signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGTERM);
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGHUP);
+	if (pthread_sigmask(SIG_BLOCK, &signals, NULL)) {
+		logger->error("Cannot block signals");
+		return;
+	}
+
+	std::thread([this, signals] {
+		int signo;
+		while (sigwait(&signals, &signo) == 0) {
+			if (isRunning()) {
+				logger->info("Received signal %d", signo);
+				stop();
+			} else {
+				logger->warn("Received signal %d while draining. Terminate", signo);
+				_exit(EXIT_FAILURE);
+			}
+		}
+	}).detach();
+}
+
+/**
+ * @brief		서버 대기 최대 시간(msec)
+ * @date		2026. 10. 16. 15:18:03
+ */
+int WorkerDaemon::getPollInterval() const {
+	return config.getConfig<int>("master.poll_interval", 100);
 }
 
 //--------------------------------------------------------------------------------
+/**
+ * @brief		AudioBuffer 해제
+ * @date		2026. 10. 16. 10:12:31
+ */
+AudioBuffer::~AudioBuffer() {
+	clear();
+}
+
+/**
+ * @brief		네트워크 파일 시스템 여부
+ * @details		NFS/SMB 등에서는 매핑 중에 원격 파일이 잘리거나 아직 쓰이는 중이면 접근 시 SIGBUS 가 발생할 수 있다.
+ * @date		2026. 10. 17. 22:18:40
+ */
+static bool is_network_fs(const int fd) {
+	struct statfs fs;
+	if (fstatfs(fd, &fs) < 0)
+		return true;	// 알 수 없으면 읽기로 처리
+
+	switch (static_cast<unsigned long>(fs.f_type)) {
+	case 0x6969UL:		// NFS_SUPER_MAGIC
+	case 0x517BUL:		// SMB_SUPER_MAGIC
+	case 0xFF534D42UL:	// CIFS_MAGIC_NUMBER
+	case 0xFE534D42UL:	// SMB2_MAGIC_NUMBER
+	case 0x65735546UL:	// FUSE_SUPER_MAGIC (sshfs 등)
+	case 0x00C36400UL:	// CEPH_SUPER_MAGIC
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * @brief		파일을 읽기 전용으로 매핑
+ * @details		파일 전체를 한 번에 순차적으로 읽으므로 MADV_SEQUENTIAL 로 미리 읽기를 유도한다.\n
+ 				매핑한 파일이 잘리면 SIGBUS 가 발생하므로, 네트워크 파일 시스템이거나 allow_mmap 이 false 이면
+ 				read() 로 읽어 복사한다. 로컬 파일도 처리 중에 다른 프로세스가 자르지 않아야 한다.
+ * @date		2026. 10. 16. 10:14:02
+ * @param[in]	pathname	파일 경로
+ * @param[in]	allow_mmap	master.mmap
+ * @exception	runtime_error	파일을 열거나 매핑할 수 없음
+ */
+void AudioBuffer::map(const std::string &pathname, const bool allow_mmap) {
+	clear();
+
+	int fd = open(pathname.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw std::runtime_error(std::strerror(errno));
+
+	struct stat st;
+	if (fstat(fd, &st) < 0) {
+		int ret = errno;
+		close(fd);
+		throw std::runtime_error(std::strerror(ret));
+	}
+	if (st.st_size == 0) {	// 빈 파일은 매핑하지 않음
+		close(fd);
+		return;
+	}
+
+	if (!allow_mmap || is_network_fs(fd)) {
+		owned.resize(static_cast<std::size_t>(st.st_size));
+		std::size_t total = 0;
+		while (total < owned.size()) {
+			ssize_t bytes = read(fd, owned.data() + total, owned.size() - total);
+			if (bytes < 0 && errno == EINTR)
+				continue;
+			if (bytes < 0) {
+				int ret = errno;
+				close(fd);
+				std::vector<char>().swap(owned);
+				throw std::runtime_error(std::strerror(ret));
+			}
+			if (bytes == 0)	// 읽는 중에 잘린 파일
+				break;
+			total += static_cast<std::size_t>(bytes);
+		}
+		close(fd);
+		owned.resize(total);
+		return;
+	}
+
+	// 매핑 후에는 디스크립터를 닫아도 유지됨
+	void *addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	int ret = errno;
+	close(fd);
+	if (addr == MAP_FAILED)
+		throw std::runtime_error(std::strerror(ret));
+	madvise(addr, st.st_size, MADV_SEQUENTIAL);
+
+	mapped = (char *) addr;
+	mapped_size = static_cast<std::size_t>(st.st_size);
+}
+
+/**
+ * @brief		수신 데이터 추가
+ * @date		2026. 10. 16. 10:15:40
+ */
+void AudioBuffer::append(const char *source, const std::size_t bytes) {
+	owned.insert(owned.end(), source, source + bytes);
+}
+
+/**
+ * @brief		변환된 데이터로 교체
+ * @details		복사하지 않고 source 의 메모리를 넘겨받는다.
+ * @date		2026. 10. 17. 16:12:48
+ */
+void AudioBuffer::assign(std::vector<char> &&source) {
+	clear();
+	owned.swap(source);
+}
+
+/**
+ * @brief		버퍼 초기화
+ * @date		2026. 10. 16. 10:16:05
+ */
+void AudioBuffer::clear() {
+	if (mapped)
+		munmap(mapped, mapped_size);
+	mapped = NULL;
+	mapped_size = 0;
+	std::vector<char>().swap(owned);
+}
+
+struct DownloadContext {
+	CURL *curl;
+	AudioBuffer *buffer;
+	bool sized;
+};
+
 /**
  * @brief		데이터 다운로드 
+ * @details		첫 블럭 수신 시 Content-Length 만큼 버퍼를 미리 할당하여 재할당을 피한다.
  * @author		Kijeong Khil (kjkhil@itfact.co.kr)
  * @date		2016. 06. 28. 22:59:42
  * @param[in]	source		받은 데이터 
  * @param[in]	size		메모리 블럭 크기 
  * @param[in]	nmemb		메모리 블럭 수 
  * @param[in]	userData	받은 데이터 
- * @return		Upon successful completion, a EXIT_SUCCESS is returned.\n
- 				Otherwise,
- 				a negative error code is returned indicating what went wrong.
+ * @return		처리한 데이터 크기
  */
 static size_t getData(void *source , size_t size , size_t nmemb , void *userData) {
-	const int total_size = size * nmemb;
-	const int length = total_size / sizeof(short);
-	short *data = (short *) source;
-	std::vector<short> *buffer = (std::vector<short> *) userData;
-
-	for (int i = 0; i < length; ++i) {
-		buffer->push_back(data[i]);
+	const size_t total_size = size * nmemb;
+	DownloadContext *ctx = (DownloadContext *) userData;
+
+	if (!ctx->sized) {
+		curl_off_t length = -1;
+		if (curl_easy_getinfo(ctx->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length) == CURLE_OK && length > 0)
+			ctx->buffer->reserve(static_cast<std::size_t>(length));
+		ctx->sized = true;
 	}
 
+	ctx->buffer->append((const char *) source, total_size);
 	return total_size;
 }
 
@@ -239,7 +673,7 @@ WorkerDaemon::downloadData(
 	const common::Configuration *config,	//< 설정
 	const char *workload,					//< 수신된 데이터 
 	const size_t workload_size,				//< 수신된 크기
-	std::vector<short> &buffer,				//< 수신할 버퍼
+	AudioBuffer &buffer,					//< 수신할 버퍼
 	const std::string *account,				//< 계정 정보 
 	log4cpp::Category *logger				//< 로거 
 ) {
@@ -257,23 +691,17 @@ WorkerDaemon::downloadData(
 		return PROTOCOL_NONE;
 	}
 
-	short sData;
 	std::string filename;
 	if (protocol == PROTOCOL_FILE) { // 파일 리드 
 		filename = std::string(workload, workload_size).substr(7);
 		logger->debug("Read file: %s", filename.c_str());
 
-		std::FILE *fp = std::fopen(filename.c_str(), "rb");
-		if (!fp) {
-			int ret = errno;
-			logger->error("%s: %s", std::strerror(ret), filename.c_str());
-			throw std::runtime_error(std::strerror(ret));
+		try {
+			buffer.map(filename, config->getConfig<bool>("master.mmap", true));
+		} catch (std::exception &e) {
+			logger->error("%s: %s", e.what(), filename.c_str());
+			throw;
 		}
-		std::shared_ptr<std::FILE> fd(fp, std::fclose);
-
-		// read 
-		while (std::fread(&sData, sizeof(short), 1, fd.get()) > 0)
-			buffer.push_back(sData);
 
 		return protocol;
 	}
@@ -288,18 +716,12 @@ WorkerDaemon::downloadData(
 			throw std::runtime_error(std::strerror(ret));
 		}
 
-
-		std::FILE *fp = std::fopen(filename.c_str(), "rb");
-		if (!fp) {
-			int ret = errno;
-			logger->error("%s: %s", std::strerror(ret), filename.c_str());
-			throw std::runtime_error(std::strerror(ret));
+		try {
+			buffer.map(filename, config->getConfig<bool>("master.mmap", true));
+		} catch (std::exception &e) {
+			logger->error("%s: %s", e.what(), filename.c_str());
+			throw;
 		}
-		std::shared_ptr<std::FILE> fd(fp, std::fclose);
-
-		// read 
-		while (std::fread(&sData, sizeof(short), 1, fd.get()) > 0)
-			buffer.push_back(sData);
 
 		return protocol;
 	}
@@ -307,40 +729,39 @@ WorkerDaemon::downloadData(
 	if (protocol == PROTOCOL_FTP && config->getConfig<bool>("master.use_ftp_ssl", false))
 		protocol = PROTOCOL_FTPS;
 
-	std::lock_guard<std::mutex> guard(curl_lock);
 	CURLcode response_code;
-	CURL *_curl = curl_easy_init();
-	if (!_curl)
+	CURL *curl = CurlPool::getHandle();
+	if (!curl)
 		throw std::runtime_error("Cannot allocation CURL");
-	std::shared_ptr<CURL> ctx(_curl, curl_easy_cleanup);
+	DownloadContext download = {curl, &buffer, false};
 
 	switch (protocol) {
 		case PROTOCOL_FTPS:	// FTPS 프로토콜
-			curl_easy_setopt(ctx.get(), CURLOPT_USE_SSL, CURLUSESSL_ALL);
+			curl_easy_setopt(curl, CURLOPT_USE_SSL, CURLUSESSL_ALL);
 			// CURLFTPAUTH_TLS // TLS first
 
 		case PROTOCOL_SFTP:	// SFTP 프로토콜
 		case PROTOCOL_FTP:	// FTP 프로토콜
 			if (account && !account->empty()) {
 				logger->debug("Account %s", account->c_str());
-				curl_easy_setopt(ctx.get(), CURLOPT_USERPWD, account->c_str()); // User Password 설정 
+				curl_easy_setopt(curl, CURLOPT_USERPWD, account->c_str()); // User Password 설정 
 			}
 
 		case PROTOCOL_HTTPS:	// HTTPS 프로토콜
 			if (config->getConfig<bool>("master.ssl_insecure", false))
-				curl_easy_setopt(ctx.get(), CURLOPT_SSL_VERIFYPEER, 0);
+				curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
 		case PROTOCOL_HTTP:		// HTTP 프로토콜
 			filename = std::string(workload, workload_size);
 			logger->debug("Download %s", filename.c_str());
 
-			// curl_easy_setopt(ctx.get(), CURLOPT_WRITEHEADER, stderr); // 헤더 출력 설정 
-			curl_easy_setopt(ctx.get(), CURLOPT_URL, filename.c_str());
-			curl_easy_setopt(ctx.get(), CURLOPT_WRITEFUNCTION, getData); // Write function 설정 
-			curl_easy_setopt(ctx.get(), CURLOPT_WRITEDATA, (void *) &buffer); // 바디 출력 설정 
-			curl_easy_setopt(ctx.get(), CURLOPT_NOPROGRESS, true);
-			// curl_easy_setopt(ctx.get(), CURLOPT_VERBOSE, true);
+			// curl_easy_setopt(curl, CURLOPT_WRITEHEADER, stderr); // 헤더 출력 설정 
+			curl_easy_setopt(curl, CURLOPT_URL, filename.c_str());
+			curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, getData); // Write function 설정 
+			curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *) &download); // 바디 출력 설정 
+			curl_easy_setopt(curl, CURLOPT_NOPROGRESS, true);
+			// curl_easy_setopt(curl, CURLOPT_VERBOSE, true);
 
-			response_code = curl_easy_perform(ctx.get());
+			response_code = curl_easy_perform(curl);
 			if (response_code != CURLE_OK) {
 				logger->alert("%s (%d)", curl_easy_strerror(response_code), response_code);
 				throw std::runtime_error(curl_easy_strerror(response_code));
@@ -397,36 +818,33 @@ WorkerDaemon::uploadData(
 	}
 	std::shared_ptr<std::FILE> fd(fp, std::fclose);
 
-	std::lock_guard<std::mutex> guard(curl_lock);
-	// curl_lock.lock();
-	CURL *_curl = curl_easy_init();
-	if (!_curl) {
+	CURL *curl = CurlPool::getHandle();
+	if (!curl) {
 		logger->error("Cannot allocation CURL");
 		return CURLE_FAILED_INIT;
 	}
-	std::shared_ptr<CURL> ctx(_curl, curl_easy_cleanup);
 
 	// FTPs 설정 
 	if (protocol == PROTOCOL_FTP && config->getConfig<bool>("use_ftp_ssl", false)) {
 		protocol = PROTOCOL_FTPS;
-		curl_easy_setopt(ctx.get(), CURLOPT_USE_SSL, CURLUSESSL_ALL);
+		curl_easy_setopt(curl, CURLOPT_USE_SSL, CURLUSESSL_ALL);
 	}
 
-	curl_easy_setopt(ctx.get(), CURLOPT_URL, uri.c_str());
+	curl_easy_setopt(curl, CURLOPT_URL, uri.c_str());
 	switch (protocol) {
 		case PROTOCOL_SFTP:		// SFTP 프로토콜
-			curl_easy_setopt(ctx.get(), CURLOPT_PROTOCOLS, CURLPROTO_SFTP);
+			curl_easy_setopt(curl, CURLOPT_PROTOCOLS, CURLPROTO_SFTP);
 
 		case PROTOCOL_FTPS:	// FTPS 프로토콜
 		case PROTOCOL_FTP:	// FTP 프로토콜
 			if (account && !account->empty())
-				curl_easy_setopt(ctx.get(), CURLOPT_USERPWD, account->c_str()); // User Password 설정 
+				curl_easy_setopt(curl, CURLOPT_USERPWD, account->c_str()); // User Password 설정 
 
-			curl_easy_setopt(ctx.get(), CURLOPT_UPLOAD, true);
-			curl_easy_setopt(ctx.get(), CURLOPT_READDATA, fd.get()); // 업로드 파일 디스크립터 
-			// curl_easy_setopt(ctx.get(), CURLOPT_INFILESIZE_LARGE, 00); // 업로드 사이즈 
+			curl_easy_setopt(curl, CURLOPT_UPLOAD, true);
+			curl_easy_setopt(curl, CURLOPT_READDATA, fd.get()); // 업로드 파일 디스크립터 
+			// curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, 00); // 업로드 사이즈 
 			if (config->getConfig<bool>("ssl_insecure", false))
-				curl_easy_setopt(ctx.get(), CURLOPT_SSL_VERIFYPEER, 0);
+				curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
 			break;
 
 		default:	// 알 수 없는 프로토콜 
@@ -435,13 +853,13 @@ WorkerDaemon::uploadData(
 	}
 
 	logger->debug("Upload file: %s", pathname.c_str());
-	CURLcode response_code = curl_easy_perform(ctx.get());
+	CURLcode response_code = curl_easy_perform(curl);
 	if (response_code != CURLE_OK)
 		logger->warn("Cannot upload, %s", curl_easy_strerror(response_code));
 	else {
 		double speed_upload, total_time;
-		curl_easy_getinfo(ctx.get(), CURLINFO_SPEED_UPLOAD, &speed_upload);
-		curl_easy_getinfo(ctx.get(), CURLINFO_TOTAL_TIME, &total_time);
+		curl_easy_getinfo(curl, CURLINFO_SPEED_UPLOAD, &speed_upload);
+		curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &total_time);
 		logger->debug("Done: %.3f bytes/sec during %.3f seconds", speed_upload, total_time);
 	}
 